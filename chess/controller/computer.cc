@@ -1,22 +1,39 @@
 #include <algorithm>
+#include <chrono>
+#include <cctype>
 #include <cstdlib>
 #include <iostream>
 #include <string>
-#include <vector>
-#include <tuple>
+#include <thread>
 #include <random>
+#include <utility>
 #include "computer.h"
+#include "parallelSearch.h"
+#include "search.h"
 #include "../model/board.h"
 #include "../shared/colour.h"
 #include "../shared/coordinate.h"
 
 std::mt19937 ComputerPlayer::rng{std::random_device{}()};
 
+namespace {
+    Search::Limits defaultLimits() {
+        Search::Limits limits;
+        limits.moveTimeMs = ComputerPlayer::DEFAULT_MOVE_TIME_MS;
+        return limits;
+    }
+}
+
 ComputerPlayer::ComputerPlayer(Board* board, Colour colour, int level)
-    : Player{board, colour}, level{level} {}
+    : ComputerPlayer{board, colour, level, defaultLimits()} {}
+
+ComputerPlayer::ComputerPlayer(Board* board, Colour colour, int level, const Search::Limits& limits)
+    : Player{board, colour}, level{level}, limits{limits}, clockRemainingMs{-1}, clockIncrementMs{0}, clockMovesToGo{0},
+    hashSizeMB{TranspositionTable::DEFAULT_SIZE_MB}, threads{std::max(1, static_cast<int>(std::thread::hardware_concurrency()))},
+    pondering{false}, statistics{Statistics::Off}, bookMaxPly{0} {}
 
 ComputerPlayer::ComputerPlayer(Board* board, Colour colour)
-    : Player{board, colour}, level{0} {
+    : ComputerPlayer{board, colour, 0} {
         std::cout << "Choose level for " << (colour == Colour::Black ? "black" : "white") << " AI opponent: ";
         while (level < 1 || level > 4)
         {
@@ -32,6 +49,15 @@ bool ComputerPlayer::takeTurn() {
         std::cout << "Black's turn: ";
     }
 
+    //known opening moves are played straight from the book, whatever the level
+    Move fromBook = bookMove();
+    if (!fromBook.isNull()) {
+        if (ponderer) {
+            ponderer->stop();
+        }
+        return playMove(fromBook);
+    }
+
     bool turnTaken;
 
     switch (level)
@@ -53,238 +79,283 @@ bool ComputerPlayer::takeTurn() {
     return turnTaken;
 }
 
-bool ComputerPlayer::levelOne() {
-    std::vector<std::unique_ptr<Piece>> myPieces {};
-
-    for (int i = 0; i < board->getBoardDimension(); ++i) {
-        for (int j = 0; j < board->getBoardDimension(); ++j) {
-            if (board->getPiece(i, j) != nullptr && board->getPiece(i, j)->getColour() == colour) {
-                myPieces.push_back(std::move(board->getPiece(i, j)));
-            }
-        }
+void ComputerPlayer::gameOver() {
+    if (ponderer) {
+        ponderer->stop();
     }
+}
 
-    while (myPieces.size() > 0)
-    {
-        int randPiece = std::uniform_int_distribution<int>(0, myPieces.size() - 1)(rng);
+bool ComputerPlayer::configure(const Settings& settings) {
+    limits.moveTimeMs = settings.moveTimeMs;
+    limits.depth = settings.depth;
+    limits.nodes = settings.nodes;
+    if (settings.clockMs >= 0) {
+        setClock(settings.clockMs, settings.incrementMs, settings.movesToGo);
+    }
+    if (settings.threads > 0) {
+        setThreads(settings.threads);
+    }
+    if (settings.hashSizeMB != hashSizeMB) {
+        setHashSize(settings.hashSizeMB);
+    }
+    Search::Options options = settings.searchOptions;
+    options.evaluator = Search::Evaluator::Classical; //until a network is loaded below
+    setSearchOptions(options);
 
-        std::vector<Coordinate::Coordinate> validMoves = myPieces[randPiece]->getValidLegalMoves();
+    bool loaded = true;
+    if (!settings.networkPath.empty()) {
+        loaded = loadNetwork(settings.networkPath) && loaded;
+    }
+    if (!settings.bookPath.empty()) {
+        loaded = setBook(settings.bookPath, settings.bookMaxPly) && loaded;
+    }
+    if (!settings.tablebaseDirectory.empty()) {
+        loaded = loadTablebases(settings.tablebaseDirectory) > 0 && loaded;
+    }
+    setStatistics(settings.statistics);
+    return loaded;
+}
 
-        if (validMoves.size() == 0) {
-            myPieces.erase(myPieces.begin() + randPiece);
-            continue;
-        }
+void ComputerPlayer::setClock(int64_t remainingMs, int64_t incrementMs, int movesToGo) {
+    clockRemainingMs = remainingMs;
+    clockIncrementMs = incrementMs;
+    clockMovesToGo = movesToGo;
+}
 
-        int randMove = std::uniform_int_distribution<int>(0, validMoves.size() - 1)(rng);
+void ComputerPlayer::setHashSize(size_t megabytes) {
+    hashSizeMB = megabytes;
+    ponderer.reset();
+    transpositionTable.reset();
+}
 
-        bool turnTaken = board->takeTurn(myPieces[randPiece]->getPosition(), validMoves[randMove], colour);
+void ComputerPlayer::setThreads(int threads) {
+    this->threads = std::max(1, threads);
+}
 
-        if (turnTaken)
-        {
-            int promotionRow = colour == Colour::White ? 7 : 0;
-            if (myPieces[randPiece]->getPieceType() == Piece::PieceType::Pawn && validMoves[randMove].row == promotionRow) {
-                board->promote(validMoves[randMove], Piece::PieceType::Queen, colour);
-                std::cout << "move " << Coordinate::cartesianToChess(myPieces[randPiece]->getPosition()) << " "
-                    << Coordinate::cartesianToChess(validMoves[randMove]) << " Q" << std::endl;
-            }
-            else {
-                std::cout << "move " << Coordinate::cartesianToChess(myPieces[randPiece]->getPosition()) << " "
-                    << Coordinate::cartesianToChess(validMoves[randMove]) << std::endl;
-            }
+void ComputerPlayer::setSearchOptions(const Search::Options& options) {
+    searchOptions = options;
+}
 
-            return true;
-        }
+void ComputerPlayer::setPondering(bool pondering) {
+    this->pondering = pondering;
+    if (!pondering) {
+        gameOver();
     }
+}
 
-    return false;
+void ComputerPlayer::setStatistics(Statistics statistics) {
+    this->statistics = statistics;
 }
 
-bool ComputerPlayer::levelTwo() {
-    std::vector<std::unique_ptr<Piece>> myPieces {};
-
-    Coordinate::Coordinate enemyKingPos;
-
-    for (int i = 0; i < board->getBoardDimension(); ++i) {
-        for (int j = 0; j < board->getBoardDimension(); ++j) {
-            if (board->getPiece(i, j) != nullptr) {
-                if (board->getPiece(i, j)->getColour() == colour) {
-                    myPieces.push_back(std::move(board->getPiece(i, j)));
-                }
-                else if (board->getPiece(i, j)->getColour() != colour && board->getPiece(i, j)->getPieceType() == Piece::PieceType::King) {
-                    enemyKingPos = board->getPiece(i, j)->getPosition();
-                }
-            }
-        }
+bool ComputerPlayer::setBook(const std::string& path, int maxPly) {
+    bookMaxPly = maxPly;
+    return book.open(path);
+}
+
+Move ComputerPlayer::bookMove() const {
+    if (!book.isOpen() || board->getPlyCount() >= bookMaxPly) {
+        return Move{};
     }
+    Board position{*board};
+    position.setSideToMove(colour);
+    return book.pickMove(position, rng);
+}
 
-    std::vector<ChessMove> moves = {};
+bool ComputerPlayer::loadNetwork(const std::string& path) {
+    std::unique_ptr<Nnue::Network> loaded{new Nnue::Network};
+    if (!loaded->load(path)) {
+        return false;
+    }
 
-    for (auto& piece : myPieces) {
-        std::vector<Coordinate::Coordinate> validMoves = piece->getValidLegalMoves();
+    gameOver(); //a ponder search may still be using the old network
+    network = std::move(loaded);
+    searchOptions.evaluator = Search::Evaluator::Neural;
+    return true;
+}
 
-        for (auto& coord : validMoves) {
-            std::unique_ptr<Piece> enemy = board->getPiece(coord);
+int ComputerPlayer::loadTablebases(const std::string& directory) {
+    gameOver(); //a ponder search may still be probing the old tables
+    return tablebase.open(directory);
+}
 
-            int checkBonus = piece->canTargetSquareFrom(coord, enemyKingPos) ? 3 : 0;
-            int takePoints = enemy == nullptr ? 0 : enemy->toValue();
+bool ComputerPlayer::playMove(Move move) {
+    if (!board->takeTurn(move, colour)) {
+        return false;
+    }
 
-            moves.push_back(ChessMove{piece->getPosition(), coord, checkBonus + takePoints});
-        }
+    std::cout << "move " << Coordinate::cartesianToChess(Bitboards::toCoordinate(move.from())) << " "
+                << Coordinate::cartesianToChess(Bitboards::toCoordinate(move.to()));
+    if (move.isPromotion()) {
+        std::cout << " " << static_cast<char>(std::toupper(board->getPiece(Bitboards::toCoordinate(move.to()))->toChar()));
     }
+    std::cout << std::endl;
 
-    std::shuffle(moves.begin(), moves.end(), rng);
+    return true;
+}
 
-    std::sort(moves.begin(), moves.end(), [](const ChessMove& a, const ChessMove& b) {
-        return a.point < b.point;
-    });
+int ComputerPlayer::promotionGain(Move move) {
+    if (!move.isPromotion()) {
+        return 0;
+    }
+    return Piece::valueOf(move.promotionType()) - Piece::valueOf(Piece::PieceType::Pawn);
+}
 
-    while (moves.size() > 0) {
-        bool turnTaken = board->takeTurn(moves.back().from, moves.back().to, colour);
+bool ComputerPlayer::levelOne() {
+    MoveList moves = board->generateLegalMoves(colour);
+    if (moves.empty()) {
+        return false;
+    }
 
-        if (turnTaken) {
-            int promotionRow = colour == Colour::White ? 7 : 0;
-            if (board->getPiece(moves.back().to)->getPieceType() == Piece::PieceType::Pawn && moves.back().to.row == promotionRow) {
-                board->promote(moves.back().to, Piece::PieceType::Queen, colour);
-                std::cout << "move " << Coordinate::cartesianToChess(moves.back().from) << " "
-                            << Coordinate::cartesianToChess(moves.back().to) << " Q" << std::endl;
-            }
-            else {
-                std::cout << "move " << Coordinate::cartesianToChess(moves.back().from) << " "
-                            << Coordinate::cartesianToChess(moves.back().to) << std::endl;
-            }
+    int randMove = std::uniform_int_distribution<int>(0, moves.size() - 1)(rng);
+    return playMove(moves[randMove]);
+}
 
-            return true;
-        }
+bool ComputerPlayer::levelTwo() {
+    MoveList moves = board->generateLegalMoves(colour);
+
+    std::shuffle(moves.begin(), moves.end(), rng); //random choice among equally scored moves
 
-        moves.pop_back();
+    for (int i = 0; i < moves.size(); i++) {
+        Move move = moves[i];
+        Coordinate::Coordinate to = Bitboards::toCoordinate(move.to());
+        int checkBonus = board->givesCheck(move) ? 3 : 0;
+        int takePoints = move.isCapture() && board->isOccupied(to) ? Piece::valueOf(board->getPieceTypeAt(to)) : 0;
+        moves.scoreAt(i) = checkBonus + takePoints + promotionGain(move);
     }
 
-    return false;
-}
+    moves.sort();
 
-bool ComputerPlayer::levelThree() {
-    std::vector<std::unique_ptr<Piece>> myPieces {};
-    std::vector<std::unique_ptr<Piece>> enemyPieces {};
-
-    Coordinate::Coordinate enemyKingPos;
-
-    for (int i = 0; i < board->getBoardDimension(); ++i) {
-        for (int j = 0; j < board->getBoardDimension(); ++j) {
-            if (board->getPiece(i, j) != nullptr) {
-                if (board->getPiece(i, j)->getColour() == colour) {
-                    myPieces.push_back(std::move(board->getPiece(i, j)));
-                }
-                else {
-                    if (board->getPiece(i, j)->getPieceType() == Piece::PieceType::King) {
-                        enemyKingPos = board->getPiece(i, j)->getPosition();
-                    }
-                    enemyPieces.push_back(std::move(board->getPiece(i, j)));
-                }
-            }
+    for (Move move : moves) {
+        if (playMove(move)) {
+            return true;
         }
     }
 
-    std::vector<bool> dangerZones = std::vector<bool>(board->getBoardDimension() * board->getBoardDimension());
+    return false;
+}
 
-    for (auto& enemy : enemyPieces) {
-        std::vector<Coordinate::Coordinate> enemyMoves = enemy->getValidLegalMoves();
+bool ComputerPlayer::levelThree() {
+    Colour enemyColour = colour == Colour::White ? Colour::Black : Colour::White;
 
-        for (auto& danger : enemyMoves) {
-            dangerZones[danger.row * board->getBoardDimension() + danger.col] = true;
-        }
+    Bitboard dangerZones = 0;
+    for (Move enemyMove : board->generateLegalMoves(enemyColour)) {
+        dangerZones |= Bitboards::squareBB(enemyMove.to());
     }
 
-    std::vector<ChessMove> moves = {};
+    MoveList moves = board->generateLegalMoves(colour);
 
-    for (auto& piece : myPieces) {
-        std::vector<Coordinate::Coordinate> validMoves = piece->getValidLegalMoves();
+    std::shuffle(moves.begin(), moves.end(), rng); //random choice among equally scored moves
 
-        for (auto& coord : validMoves) {
-            std::unique_ptr<Piece> enemy = board->getPiece(coord);
-            Coordinate::Coordinate pos = piece->getPosition();
-            bool inDanger = dangerZones[pos.row * board->getBoardDimension() + pos.col];
-            bool willBeInDanger = dangerZones[coord.row * board->getBoardDimension() + coord.col];
+    for (int i = 0; i < moves.size(); i++) {
+        Move move = moves[i];
+        Coordinate::Coordinate to = Bitboards::toCoordinate(move.to());
+        bool inDanger = dangerZones & Bitboards::squareBB(move.from());
+        bool willBeInDanger = dangerZones & Bitboards::squareBB(move.to());
+        int pieceValue = Piece::valueOf(board->getPieceTypeAt(Bitboards::toCoordinate(move.from())));
 
-            int checkBonus = piece->canTargetSquareFrom(coord, enemyKingPos) && !willBeInDanger ? 3 : 0;
-            int takePoints = enemy == nullptr ? 0 : enemy->toValue();
-            int escOrTrade = inDanger == true && willBeInDanger == false ? piece->toValue() :
-                (inDanger == false && willBeInDanger == true ? -piece->toValue() : 0);
+        int checkBonus = board->givesCheck(move) && !willBeInDanger ? 3 : 0;
+        int takePoints = move.isCapture() && board->isOccupied(to) ? Piece::valueOf(board->getPieceTypeAt(to)) : 0;
+        int escOrTrade = inDanger == true && willBeInDanger == false ? pieceValue :
+            (inDanger == false && willBeInDanger == true ? -pieceValue : 0);
 
-            moves.push_back(ChessMove{piece->getPosition(), coord, checkBonus + takePoints + escOrTrade});
-        }
+        moves.scoreAt(i) = checkBonus + takePoints + escOrTrade + promotionGain(move);
     }
 
-    std::shuffle(moves.begin(), moves.end(), rng);
-
-    std::sort(moves.begin(), moves.end(), [](const ChessMove& a, const ChessMove& b) {
-        return a.point < b.point;
-    });
-
-    while (moves.size() > 0) {
-        bool turnTaken = board->takeTurn(moves.back().from, moves.back().to, colour);
-
-        if (turnTaken) {
-            int promotionRow = colour == Colour::White ? 7 : 0;
-            if (board->getPiece(moves.back().to)->getPieceType() == Piece::PieceType::Pawn && moves.back().to.row == promotionRow) {
-                board->promote(moves.back().to, Piece::PieceType::Queen, colour);
-                std::cout << "move " << Coordinate::cartesianToChess(moves.back().from) << " "
-                            << Coordinate::cartesianToChess(moves.back().to) << " Q" << std::endl;
-            }
-            else {
-                std::cout << "move " << Coordinate::cartesianToChess(moves.back().from) << " "
-                            << Coordinate::cartesianToChess(moves.back().to) << std::endl;
-            }
+    moves.sort();
 
+    for (Move move : moves) {
+        if (playMove(move)) {
             return true;
         }
-
-        moves.pop_back();
     }
 
     return false;
 }
 
 bool ComputerPlayer::levelFour() {
-    std::vector<std::unique_ptr<Piece>> myPieces {};
-
-    for (int i = 0; i < board->getBoardDimension(); ++i) {
-        for (int j = 0; j < board->getBoardDimension(); ++j) {
-            if (board->getPiece(i, j) != nullptr) {
-                if (board->getPiece(i, j)->getColour() == colour)
-                    myPieces.push_back(std::move(board->getPiece(i, j)));
-            }
+    //search a copy so the observers never see the moves being tried
+    Board position = searchBoard();
+    position.setSideToMove(colour);
+
+    bool onClock = clockRemainingMs >= 0;
+    auto start = std::chrono::steady_clock::now();
+
+    if (!transpositionTable) {
+        transpositionTable.reset(new TranspositionTable{hashSizeMB});
+        ponderer.reset(new Ponderer{*transpositionTable, pawnTables});
+    }
+    //if the opponent played the reply we pondered, that search goes on as this one with what is left of the budget;
+    //otherwise it is dropped, though what it found stays in the table
+    Search::Limits searchLimits = moveLimits();
+    Move bestMove = ponderer->ponderHit(board->getKey(), searchLimits.moveTimeMs);
+    SearchStats stats;
+    if (!bestMove.isNull()) {
+        stats = ponderer->getStats();
+    }
+    else {
+        ParallelSearch search{position, *transpositionTable, threads, nullptr, &pawnTables};
+        search.setOptions(searchOptions);
+        if (statistics != Statistics::Off) { //stderr keeps them out of the game's own output
+            Statistics format = statistics;
+            search.setReporter([format](const SearchStats& stats) {
+                std::cerr << (format == Statistics::Json ? stats.toJson() : stats.toLine()) << std::endl;
+            });
+        }
+        bestMove = search.think(searchLimits);
+        if (bestMove.isNull()) {
+            return false;
         }
+        stats = search.getStats();
+    }
+    if (statistics != Statistics::Off) { //the whole search, helper threads included
+        std::cerr << (statistics == Statistics::Json ? stats.toJson() : stats.toLine()) << std::endl;
     }
-    
-    std::vector<ChessMove> legalMoves{};
 
-    for (auto& piece : myPieces) {
-        std::vector<Coordinate::Coordinate> validMoves = piece->getValidLegalMoves();
-        for (auto& coord : validMoves) {
-            legalMoves.push_back(ChessMove{piece->getPosition(), coord, 0});
+    if (onClock) { //our own thinking time comes off the clock, the increment goes back on
+        clockRemainingMs -= std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        clockRemainingMs = std::max<int64_t>(clockRemainingMs, 0) + clockIncrementMs;
+        if (clockMovesToGo > 0) {
+            --clockMovesToGo;
         }
     }
 
-    Board *testBoard = new Board{*board};
+    if (!playMove(bestMove)) {
+        return false;
+    }
+    if (pondering) {
+        startPondering(stats.principalVariation.size() > 1 ? stats.principalVariation[1] : Move{});
+    }
+    return true;
+}
+
+Search::Limits ComputerPlayer::moveLimits() const {
+    return clockRemainingMs >= 0 ? Search::Limits::forClock(clockRemainingMs, clockIncrementMs, clockMovesToGo) : limits;
+}
 
-    int max = std::numeric_limits<int>::min();
-    ChessMove maxMove{};
+Board ComputerPlayer::searchBoard() const {
+    Board copy{*board};
+    copy.setTablebase(&tablebase);
+    if (searchOptions.evaluator == Search::Evaluator::Neural) {
+        copy.setNetwork(network.get());
+    }
+    return copy;
+}
 
-    for (auto chessMove : legalMoves) {
-        testBoard->takeTurn(chessMove.from, chessMove.to, colour);
-        int score = minimax(testBoard, 1, true);
-        if (score > max) {
-            max = score;
-            maxMove = chessMove;
+void ComputerPlayer::startPondering(Move reply) {
+    //without a principal variation that long, the reply is the table's best move in the position after ours
+    TranspositionTable::Entry entry;
+    if (reply.isNull()) {
+        if (!transpositionTable->probe(board->getKey(), entry) || entry.move.isNull()) {
+            return;
+        }
+        reply = entry.move;
+        Colour opponent = colour == Colour::White ? Colour::Black : Colour::White;
+        if (!board->generateLegalMoves(opponent, Bitboards::squareBB(reply.from())).contains(reply)) {
+            return; //a key collision
         }
-        testBoard->undoTurn();
     }
 
-    std::cout << "move " << Coordinate::cartesianToChess(maxMove.from) << " "
-        << Coordinate::cartesianToChess(maxMove.to) << std::endl;
-    board->takeTurn(maxMove.from, maxMove.to, colour);
-
-    delete testBoard;
-
-    return true;
+    Search::Limits ponderLimits = moveLimits(); //bounded, so a long think by the opponent doesn't keep us searching forever
+    ponderLimits.moveTimeMs *= PONDER_TIME_FACTOR;
+    ponderer->start(searchBoard(), reply, ponderLimits, threads, searchOptions);
 }
@@ -1,40 +1,100 @@
 #ifndef COMPUTERPLAYER_H
 #define COMPUTERPLAYER_H
-#include <vector>
-#include <tuple>
+#include <memory>
 #include <random>
 #include "../shared/colour.h"
 #include "../shared/coordinate.h"
+#include "../model/move.h"
+#include "../model/nnue.h"
+#include "../model/openingBook.h"
+#include "../model/tablebase.h"
+#include "./search.h"
+#include "./ponderer.h"
+#include "./transpositionTable.h"
 #include "./player.h"
 class Board;
 
 class ComputerPlayer : public Player {
     public:
+        static const int DEFAULT_MOVE_TIME_MS = 1000;
+        static const int DEFAULT_BOOK_PLY = 16;
+        static const int PONDER_TIME_FACTOR = 4; //a ponder search may use this many of our own move budgets
+
+        enum class Statistics {
+            Off,
+            Line, //SearchStats::toLine
+            Json //SearchStats::toJson
+        };
+
+        struct Settings { //engine configuration (from the command line), given to every computer player by Game
+            std::string networkPath; //NNUE weights for level four, the classical evaluation if empty
+            std::string bookPath; //Polyglot opening book, none if empty
+            int bookMaxPly = DEFAULT_BOOK_PLY;
+            std::string tablebaseDirectory; //where the endgame tables are, none if empty
+            Statistics statistics = Statistics::Off;
+            int64_t moveTimeMs = DEFAULT_MOVE_TIME_MS; //level four's limits per move, 0 for none
+            int depth = Search::MAX_PLY;
+            uint64_t nodes = 0;
+            int64_t clockMs = -1; //when not negative, level four budgets each move from a clock of this many milliseconds instead
+            int64_t incrementMs = 0;
+            int movesToGo = 0;
+            int threads = 0; //0 for one per core
+            size_t hashSizeMB = TranspositionTable::DEFAULT_SIZE_MB;
+            Search::Options searchOptions; //the evaluator is chosen by networkPath
+        };
+
         ComputerPlayer(Board* board, Colour colour, int level);
+        ComputerPlayer(Board* board, Colour colour, int level, const Search::Limits& limits); //limits for level four
         ComputerPlayer(Board* board, Colour colour);
         ~ComputerPlayer() = default; //DTOR
 
+        bool configure(const Settings& settings); //false if something settings names couldn't be loaded
+
         bool takeTurn() override;
+        void gameOver() override; //stops pondering
+        void setClock(int64_t remainingMs, int64_t incrementMs, int movesToGo = 0); //level four then budgets from the clock
+        void setHashSize(size_t megabytes); //transposition table size for level four
+        void setThreads(int threads); //search threads for level four, 1 gives a deterministic single-threaded search
+        void setSearchOptions(const Search::Options& options); //pruning used by level four
+        void setPondering(bool pondering); //level four keeps searching on the opponent's time, off by default
+        bool setBook(const std::string& path, int maxPly = DEFAULT_BOOK_PLY); //book moves are played at every level while fewer than maxPly moves were made
+        bool loadNetwork(const std::string& path); //level four then evaluates with the NNUE weights in path (see Nnue::Network)
+        void setStatistics(Statistics statistics); //level four prints each iteration's statistics and line to stderr, off by default
+        int loadTablebases(const std::string& directory); //level four then plays the endings found in directory perfectly, returns how many tables were found
 
     protected:
 
     private:
         static std::mt19937 rng;
 
-        struct ChessMove {
-            Coordinate::Coordinate from;
-            Coordinate::Coordinate to;
-            int point;
-        };
-
         int level;
+        Search::Limits limits; //per move limits for level four when there is no clock
+        int64_t clockRemainingMs; //negative when playing without a clock
+        int64_t clockIncrementMs;
+        int clockMovesToGo;
+        size_t hashSizeMB;
+        int threads;
+        Search::Options searchOptions;
+        bool pondering;
+        Statistics statistics;
+        OpeningBook book;
+        int bookMaxPly;
+        std::unique_ptr<Nnue::Network> network; //used by search boards, including the ponderer's, so declared before it
+        Tablebase tablebase; //also used by search boards
+        std::unique_ptr<TranspositionTable> transpositionTable; //allocated on level four's first move, kept between moves
+        std::vector<std::unique_ptr<PawnTable>> pawnTables; //one per search thread, kept for the whole game
+        std::unique_ptr<Ponderer> ponderer; //shares transpositionTable and pawnTables, so it is declared (and destroyed) after them
 
+        bool playMove(Move move); //takes the turn and prints the move (with the promoted piece, if any)
+        Move bookMove() const; //null once out of the book
+        static int promotionGain(Move move); //material gained by promoting, 0 for other moves
+        Search::Limits moveLimits() const; //level four's limits for the next move
+        Board searchBoard() const; //copy of the board to search, with the tablebase and (if the neural evaluator is selected) the network
+        void startPondering(Move reply); //on the reply our last search expects (from the table if null)
         bool levelOne();
         bool levelTwo();
         bool levelThree();
         bool levelFour();
-        int minimax(Board *b, int depth, bool maximizing);
-        int evaluate(Board *b);
 };
 
 #endif
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include "game.h"
@@ -9,6 +10,8 @@
 
 Game::Game(Board* board, Player::PlayerType whitePlayerType, Player::PlayerType blackPlayerType):
     board{board}, 
+    whitePlayerType{whitePlayerType},
+    blackPlayerType{blackPlayerType},
     currentTurn{Colour::White} {
         if (whitePlayerType == Player::PlayerType::Human)
             whitePlayer = new HumanPlayer{board, Colour::White};
@@ -19,6 +22,8 @@ Game::Game(Board* board, Player::PlayerType whitePlayerType, Player::PlayerType
             blackPlayer = new HumanPlayer{board, Colour::Black};
         else
             blackPlayer = new ComputerPlayer{board, Colour::Black}; 
+
+        updatePondering();
     }
 
 Game::~Game() {
@@ -44,6 +49,7 @@ void Game::setUp() { //this method interfaces with std::cout
 
     //delete current board and initialize new board
     board->reset();
+    board->setSideToMove(currentTurn);
     notifyObservers();
 
     //command handling
@@ -79,6 +85,7 @@ void Game::setUp() { //this method interfaces with std::cout
             } else {
                 std::cout << "Invalid colour.\n";
             }
+            board->setSideToMove(currentTurn);
             notifyObservers();
         }
         else if (command == "done") {
@@ -133,6 +140,8 @@ void Game::play() {
         }
 
         if (hasEnded) {
+            whitePlayer->gameOver();
+            blackPlayer->gameOver();
             notifyObservers();
             board->resetDefaultChess();
             currentTurn = Colour::White;
@@ -147,7 +156,9 @@ void Game::updatePlayer(Colour colour, Player::PlayerType playerType, int comput
         newPlayer = new HumanPlayer{board, colour};
     }
     else {
-        newPlayer = new ComputerPlayer{board, colour, computerLevel};
+        ComputerPlayer* computer = new ComputerPlayer{board, colour, computerLevel};
+        computer->configure(computerSettings);
+        newPlayer = computer;
     }
 
     if (colour == Colour::Black) {
@@ -162,6 +173,34 @@ void Game::updatePlayer(Colour colour, Player::PlayerType playerType, int comput
         }
         whitePlayer = newPlayer;
     }
+
+    if (colour == Colour::Black) {
+        blackPlayerType = playerType;
+    }
+    else {
+        whitePlayerType = playerType;
+    }
+    updatePondering();
+}
+
+void Game::setComputerSettings(const ComputerPlayer::Settings& settings) {
+    computerSettings = settings;
+    if (whitePlayerType == Player::PlayerType::Computer) {
+        static_cast<ComputerPlayer*>(whitePlayer)->configure(settings);
+    }
+    if (blackPlayerType == Player::PlayerType::Computer) {
+        static_cast<ComputerPlayer*>(blackPlayer)->configure(settings);
+    }
+}
+
+void Game::updatePondering() {
+    //two engines pondering in one process would only take cpu time from each other
+    if (whitePlayerType == Player::PlayerType::Computer) {
+        static_cast<ComputerPlayer*>(whitePlayer)->setPondering(blackPlayerType == Player::PlayerType::Human);
+    }
+    if (blackPlayerType == Player::PlayerType::Computer) {
+        static_cast<ComputerPlayer*>(blackPlayer)->setPondering(whitePlayerType == Player::PlayerType::Human);
+    }
 }
 
 void Game::detachObserver(Observer* obs) {
@@ -5,6 +5,7 @@
 #include "../shared/colour.h"
 #include "../model/board.h"
 #include "player.h"
+#include "computer.h"
 
 class Piece;
 class Observer;
@@ -30,6 +31,7 @@ class Game {
         void setUp();
         void play();
         void updatePlayer(Colour colour, Player::PlayerType playerType, int computerLevel = 1);
+        void setComputerSettings(const ComputerPlayer::Settings& settings); //for the computer players now and later
         void detachObserver(Observer* obs);
         void attachObserver(Observer* obs);
         GameState getGameState();
@@ -43,11 +45,16 @@ class Game {
         Board* const board;
         Player* whitePlayer;
         Player* blackPlayer;
+        Player::PlayerType whitePlayerType;
+        Player::PlayerType blackPlayerType;
         float whiteScore = 0;
         float blackScore = 0;
         std::vector<Observer*> observers;
         Colour currentTurn;
         bool gameInProgress = false;
+        ComputerPlayer::Settings computerSettings;
+
+        void updatePondering(); //computers ponder only when playing a human
 };
 
 #endif
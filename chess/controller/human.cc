@@ -30,18 +30,18 @@ bool HumanPlayer::takeTurn() {
                 continue;
             }
 
-            if (!board->takeTurn(Coordinate::chessToCartesian(from), Coordinate::chessToCartesian(to), colour)) {
-                std::cout << "Invalid move, try again: ";
-                continue;
-            }
+            Coordinate::Coordinate fromPos = Coordinate::chessToCartesian(from);
+            Coordinate::Coordinate toPos = Coordinate::chessToCartesian(to);
+            Piece::PieceType newPieceType = Piece::PieceType::Queen;
 
+            //a promotion is part of the move, so the piece is read before the move is made
             if (
-                board->getPiece(to)->getPieceType() == Piece::PieceType::Pawn &&
-                ((colour == Colour::White && Coordinate::chessToCartesian(to).row == 7) || (colour == Colour::Black && Coordinate::chessToCartesian(to).row == 0))
+                board->isOccupied(fromPos) && board->getColourAt(fromPos) == colour &&
+                board->getPieceTypeAt(fromPos) == Piece::PieceType::Pawn &&
+                ((colour == Colour::White && toPos.row == 7) || (colour == Colour::Black && toPos.row == 0))
             ) {
                 while (true) {
                     std::string type;
-                    Piece::PieceType newPieceType;
                     
                     std::cin >> type;
 
@@ -69,13 +69,14 @@ bool HumanPlayer::takeTurn() {
                         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                         continue;
                     }
-
-                    if (board->promote(Coordinate::chessToCartesian(to), newPieceType, colour))
-                        break;
-                    else
-                        std::cout << "Invalid promotion, try again." << std::endl;
+                    break;
                 }
             }
+
+            if (!board->takeTurn(fromPos, toPos, colour, newPieceType)) {
+                std::cout << "Invalid move, try again: ";
+                continue;
+            }
             
             return true;
         }
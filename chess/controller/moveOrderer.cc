@@ -0,0 +1,103 @@
+#include "moveOrderer.h"
+#include "../model/board.h"
+
+namespace {
+    const int TABLE_MOVE_SCORE = 2000000;
+    const int CAPTURE_SCORE = 1000000; //+ MVV-LVA, so every capture and promotion comes before the quiet moves
+    const int KILLER_SCORES[2] = {900000, 800000};
+    const int HISTORY_LIMIT = 500000; //history is halved once any entry reaches this, keeping it below the killers
+
+    //piece rank for MVV-LVA, indexed by PieceType (King, Queen, Bishop, Rook, Knight, Pawn)
+    const int ORDER_RANK[6] = {6, 5, 3, 4, 2, 1};
+
+    int rankOf(Piece::PieceType type) {
+        return ORDER_RANK[static_cast<int>(type)];
+    }
+}
+
+MoveOrderer::MoveOrderer() {
+    clear();
+}
+
+void MoveOrderer::clear() {
+    for (int ply = 0; ply < MAX_PLY; ply++) {
+        killers[ply][0] = Move{};
+        killers[ply][1] = Move{};
+    }
+    for (int c = 0; c < 2; c++) {
+        for (int from = 0; from < 64; from++) {
+            for (int to = 0; to < 64; to++) {
+                history[c][from][to] = 0;
+            }
+        }
+    }
+}
+
+void MoveOrderer::score(MoveList& moves, const Board& board, Move tableMove, int ply) const {
+    int c = Bitboards::colourIndex(board.getSideToMove());
+    if (ply >= MAX_PLY) {
+        ply = MAX_PLY - 1;
+    }
+
+    for (int i = 0; i < moves.size(); i++) {
+        Move move = moves[i];
+        int score;
+        if (move == tableMove) {
+            score = TABLE_MOVE_SCORE;
+        }
+        else if (move.isCapture() || move.isPromotion()) {
+            int victim = 0;
+            if (move.isEnPassant()) {
+                victim = rankOf(Piece::PieceType::Pawn);
+            }
+            else if (move.isCapture()) {
+                victim = rankOf(board.getPieceTypeAt(move.to()));
+            }
+            if (move.isPromotion()) {
+                victim += rankOf(move.promotionType());
+            }
+            score = CAPTURE_SCORE + victim * 16 - rankOf(board.getPieceTypeAt(move.from()));
+        }
+        else if (move == killers[ply][0]) {
+            score = KILLER_SCORES[0];
+        }
+        else if (move == killers[ply][1]) {
+            score = KILLER_SCORES[1];
+        }
+        else {
+            score = history[c][move.from()][move.to()];
+        }
+        moves.scoreAt(i) = score;
+    }
+}
+
+bool MoveOrderer::isHistoryScore(int score) {
+    return score < KILLER_SCORES[1];
+}
+
+void MoveOrderer::updateCutoff(Colour colour, Move move, int ply, int depth) {
+    if (move.isCapture() || move.isPromotion()) {
+        return; //these are already ordered by MVV-LVA
+    }
+    if (ply >= MAX_PLY) {
+        ply = MAX_PLY - 1;
+    }
+
+    if (killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    int c = Bitboards::colourIndex(colour);
+    int& entry = history[c][move.from()][move.to()];
+    entry += depth * depth;
+    if (entry >= HISTORY_LIMIT) { //age the whole table so recent cutoffs keep counting
+        for (int side = 0; side < 2; side++) {
+            for (int from = 0; from < 64; from++) {
+                for (int to = 0; to < 64; to++) {
+                    history[side][from][to] /= 2;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef MOVEORDERER_H
+#define MOVEORDERER_H
+
+#include "../model/move.h"
+#include "../model/moveList.h"
+#include "../shared/colour.h"
+class Board;
+
+// Scores moves so that the ones most likely to cause a beta cutoff are searched first:
+// the transposition table move, then captures by most valuable victim / least valuable attacker,
+// then the two killer moves of the ply, then the remaining quiet moves by their history.
+class MoveOrderer {
+    public:
+        static const int MAX_PLY = 128; //deepest ply a search reaches, Search::MAX_PLY is defined from it
+
+        MoveOrderer(); //CTOR
+
+        void clear();
+        void score(MoveList& moves, const Board& board, Move tableMove, int ply) const; //fills the list's scores
+        void updateCutoff(Colour colour, Move move, int ply, int depth); //move caused a beta cutoff at ply
+        static bool isHistoryScore(int score); //was the score given by history alone, i.e. to a quiet move that isn't a killer or the table move
+
+    private:
+        Move killers[MAX_PLY][2]; //quiet moves that recently caused a cutoff at each ply, newest first
+        int history[2][64][64]; //butterfly table: [colour][from][to], rewarded by depth squared on cutoffs
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include <thread>
+#include "parallelSearch.h"
+#include "../model/board.h"
+
+ParallelSearch::ParallelSearch(const Board& board, TranspositionTable& transpositionTable, int threads, const std::atomic<bool>* stopSignal,
+                               std::vector<std::unique_ptr<PawnTable>>* pawnTables):
+    transpositionTable{transpositionTable}, stopHelpers{false} {
+        if (threads < 1) {
+            threads = 1;
+        }
+        while (pawnTables && pawnTables->size() < threads) {
+            pawnTables->emplace_back(new PawnTable);
+        }
+        for (int i = 0; i < threads; i++) {
+            boards.emplace_back(new Board{board});
+            searches.emplace_back(new Search{*boards.back(), transpositionTable, i == 0 ? stopSignal : &stopHelpers,
+                                             pawnTables ? (*pawnTables)[i].get() : nullptr});
+        }
+    }
+
+void ParallelSearch::setOptions(const Search::Options& options) {
+    for (std::unique_ptr<Search>& search : searches) {
+        search->setOptions(options);
+    }
+}
+
+void ParallelSearch::setReporter(std::function<void(const SearchStats&)> reporter) {
+    searches[0]->setReporter(reporter);
+}
+
+Move ParallelSearch::think(const Search::Limits& limits) {
+    transpositionTable.newSearch();
+    stopHelpers.store(false);
+
+    //helpers only share the depth limit, the calling thread's search owns the clock and node budget;
+    //odd helpers start a ply deeper so the threads spread over more than one iteration at a time
+    Search::Limits helperLimits;
+    helperLimits.depth = limits.depth;
+
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < searches.size(); i++) {
+        Search* helper = searches[i].get();
+        int firstDepth = 1 + i % 2;
+        helpers.emplace_back([helper, helperLimits, firstDepth]() {
+            helper->think(helperLimits, firstDepth);
+        });
+    }
+
+    Move bestMove = searches[0]->think(limits);
+
+    stopHelpers.store(true);
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+    return bestMove;
+}
+
+int ParallelSearch::getScore() const {
+    return searches[0]->getScore();
+}
+
+int ParallelSearch::getDepth() const {
+    return searches[0]->getDepth();
+}
+
+uint64_t ParallelSearch::getNodes() const {
+    uint64_t nodes = 0;
+    for (const std::unique_ptr<Search>& search : searches) {
+        nodes += search->getNodes();
+    }
+    return nodes;
+}
+
+SearchStats ParallelSearch::getStats() const {
+    SearchStats stats = searches[0]->getStats();
+    for (int i = 1; i < searches.size(); i++) {
+        stats.add(searches[i]->getStats());
+    }
+    return stats;
+}
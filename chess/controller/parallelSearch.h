@@ -0,0 +1,40 @@
+#ifndef PARALLELSEARCH_H
+#define PARALLELSEARCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "./search.h"
+#include "./transpositionTable.h"
+class Board;
+
+// Lazy SMP: every thread runs its own iterative deepening search on a private copy of the position,
+// and the threads only cooperate through the shared transposition table. The calling thread's search
+// decides the move and its limits; helper threads are stopped as soon as it finishes.
+// With one thread nothing is spawned and the search is deterministic.
+class ParallelSearch {
+    public:
+        //stopSignal stops the whole search early, as Search's does; pawnTables, if given, holds a pawn table per
+        //thread that the caller keeps between searches (it is grown to threads tables), otherwise each thread makes its own
+        ParallelSearch(const Board& board, TranspositionTable& transpositionTable, int threads, const std::atomic<bool>* stopSignal = nullptr,
+                       std::vector<std::unique_ptr<PawnTable>>* pawnTables = nullptr);
+        ~ParallelSearch() = default; //DTOR
+
+        void setOptions(const Search::Options& options); //for every thread
+        void setReporter(std::function<void(const SearchStats&)> reporter); //reports the calling thread's iterations, see Search::setReporter
+        Move think(const Search::Limits& limits); //node limits count the calling thread's nodes only
+        int getScore() const;
+        int getDepth() const;
+        uint64_t getNodes() const; //summed over all threads
+        SearchStats getStats() const; //counters summed over all threads, depth, score and time of the calling thread's search
+
+    private:
+        TranspositionTable& transpositionTable;
+        std::atomic<bool> stopHelpers;
+        std::vector<std::unique_ptr<Board>> boards; //one per thread, index 0 belongs to the calling thread
+        std::vector<std::unique_ptr<Search>> searches;
+};
+
+#endif
@@ -0,0 +1,97 @@
+#include "pawnTable.h"
+#include "../model/board.h"
+#include "../model/pieces/pawn.h"
+
+namespace {
+    const int DOUBLED[2] = {-10, -20}; //{middlegame, endgame}, for each pawn with a friendly pawn in front of it
+    const int ISOLATED[2] = {-10, -15}; //no friendly pawns on the adjacent files
+    const int BACKWARD[2] = {-8, -10}; //can't be supported by a pawn and its stop square is held by an enemy pawn
+
+    //passed pawn bonus by rank counted from the pawn's own side
+    const int PASSED_MIDDLEGAME[8] = {0, 5, 10, 15, 25, 40, 60, 0};
+    const int PASSED_ENDGAME[8] = {0, 10, 15, 25, 45, 70, 100, 0};
+}
+
+PawnTable::PawnTable(int entries): entries(entries) {
+    clear();
+}
+
+void PawnTable::clear() {
+    //an all zero entry is the correct one for a position without pawns (pawn key 0)
+    for (Entry& entry : entries) {
+        entry = Entry{0, 0, 0};
+    }
+    probes = 0;
+    hits = 0;
+}
+
+uint64_t PawnTable::getProbes() const {
+    return probes;
+}
+
+uint64_t PawnTable::getHits() const {
+    return hits;
+}
+
+const PawnTable::Entry& PawnTable::probe(const Board& board) {
+    Key key = board.getPawnKey();
+    Entry& entry = entries[key & (entries.size() - 1)];
+    ++probes;
+    if (entry.key == key) {
+        ++hits;
+        return entry;
+    }
+
+    entry = Entry{key, 0, 0};
+    evaluate(board, entry);
+    return entry;
+}
+
+void PawnTable::evaluate(const Board& board, Entry& entry) {
+    evaluateColour(board, Colour::White, entry);
+    evaluateColour(board, Colour::Black, entry);
+}
+
+void PawnTable::evaluateColour(const Board& board, Colour colour, Entry& entry) {
+    Colour enemy = colour == Colour::White ? Colour::Black : Colour::White;
+    Bitboard ours = board.getPieces(colour, Piece::PieceType::Pawn);
+    Bitboard theirs = board.getPieces(enemy, Piece::PieceType::Pawn);
+    int sign = colour == Colour::White ? 1 : -1;
+
+    int middlegame = 0;
+    int endgame = 0;
+    Bitboard pawns = ours;
+    while (pawns) {
+        Square square = Bitboards::popLsb(pawns);
+        Bitboard ahead = Pawn::forwardRanks(colour, square);
+        bool doubled = ours & ahead & Pawn::fileMask(square);
+        bool isolated = !(ours & Pawn::adjacentFiles(square));
+
+        if (doubled) {
+            middlegame += DOUBLED[0];
+            endgame += DOUBLED[1];
+        }
+        if (isolated) {
+            middlegame += ISOLATED[0];
+            endgame += ISOLATED[1];
+        }
+        else if (!(ours & Pawn::adjacentFiles(square) & ~ahead)) {
+            //no neighbour level with or behind it: backward if an enemy pawn stops it from advancing safely
+            Square stop = colour == Colour::White ? square + 8 : square - 8;
+            if (Bitboards::pawnAttacks(colour, stop) & theirs) {
+                middlegame += BACKWARD[0];
+                endgame += BACKWARD[1];
+            }
+        }
+
+        //only the front pawn of a doubled pair can be passed
+        if (!doubled && !(theirs & Pawn::passedMask(colour, square))) {
+            int rank = colour == Colour::White ? square / 8 : 7 - square / 8;
+            middlegame += PASSED_MIDDLEGAME[rank];
+            endgame += PASSED_ENDGAME[rank];
+        }
+    }
+
+    entry.middlegame += sign * middlegame;
+    entry.endgame += sign * endgame;
+}
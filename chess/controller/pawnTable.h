@@ -0,0 +1,40 @@
+#ifndef PAWNTABLE_H
+#define PAWNTABLE_H
+
+#include <cstdint>
+#include <vector>
+#include "../model/bitboard.h"
+#include "../model/zobrist.h"
+class Board;
+
+// Caches the pawn structure evaluation (doubled, isolated, backward and passed pawns) by the board's pawn key.
+// Pawns move rarely, so nearly every leaf finds its structure already scored by a sibling.
+// Each search thread has its own table, so nothing here is shared; ComputerPlayer keeps them for the whole
+// game, so a move's search starts with the structures scored while thinking about the last ones.
+class PawnTable {
+    public:
+        static const int DEFAULT_ENTRIES = 1 << 13; //must be a power of two
+
+        struct Entry {
+            Key key;
+            int middlegame; //centipawns from white's point of view, added to Board's piece-square sums
+            int endgame;
+        };
+
+        PawnTable(int entries = DEFAULT_ENTRIES); //CTOR
+
+        const Entry& probe(const Board& board); //scores the structure and stores it on a miss
+        void clear(); //also resets the counters
+        uint64_t getProbes() const;
+        uint64_t getHits() const;
+
+    private:
+        std::vector<Entry> entries;
+        uint64_t probes;
+        uint64_t hits;
+
+        static void evaluate(const Board& board, Entry& entry);
+        static void evaluateColour(const Board& board, Colour colour, Entry& entry); //adds colour's terms to entry
+};
+
+#endif
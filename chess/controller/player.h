@@ -16,6 +16,7 @@ class Player {
         virtual ~Player() = default; //DTOR
 
         virtual bool takeTurn() = 0;
+        virtual void gameOver() {} //the game ended, players that work on the opponent's time stop here
 
     protected:
         Board* const board;
@@ -0,0 +1,69 @@
+#include "ponderer.h"
+
+Ponderer::Ponderer(TranspositionTable& transpositionTable, std::vector<std::unique_ptr<PawnTable>>& pawnTables):
+    transpositionTable{transpositionTable}, pawnTables{pawnTables}, stopSignal{false}, finished{false}, key{0} {}
+
+Ponderer::~Ponderer() {
+    stop();
+}
+
+void Ponderer::start(const Board& board, Move reply, const Search::Limits& limits, int threads, const Search::Options& options) {
+    stop();
+
+    this->board.reset(new Board{board});
+    this->board->makeMove(reply);
+    key = this->board->getKey();
+    bestMove = Move{};
+
+    stopSignal.store(false);
+    finished.store(false);
+    startTime = std::chrono::steady_clock::now();
+    search.reset(new ParallelSearch{*this->board, transpositionTable, threads, &stopSignal, &pawnTables});
+    search->setOptions(options);
+    ParallelSearch* ponderSearch = search.get();
+    thread = std::thread{[this, ponderSearch, limits]() {
+        bestMove = ponderSearch->think(limits);
+        finished.store(true);
+    }};
+}
+
+Move Ponderer::ponderHit(Key key, int64_t moveTimeMs) {
+    if (!isPondering()) {
+        return Move{};
+    }
+    if (key != this->key) {
+        stop();
+        return Move{};
+    }
+
+    //the time spent pondering counts against the budget; polled like the search's own clock, a millisecond late at most
+    auto deadline = startTime + std::chrono::milliseconds(moveTimeMs);
+    while (!finished.load()) {
+        if (moveTimeMs > 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stop();
+    return stats.depth > 0 ? bestMove : Move{}; //stopped before finishing an iteration, the move isn't trusted
+}
+
+void Ponderer::stop() {
+    if (!isPondering()) {
+        return;
+    }
+
+    stopSignal.store(true);
+    thread.join();
+    stats = search->getStats();
+    search.reset();
+    board.reset();
+}
+
+bool Ponderer::isPondering() const {
+    return thread.joinable();
+}
+
+const SearchStats& Ponderer::getStats() const {
+    return stats;
+}
@@ -0,0 +1,48 @@
+#ifndef PONDERER_H
+#define PONDERER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../model/board.h"
+#include "../model/move.h"
+#include "./parallelSearch.h"
+#include "./search.h"
+#include "./transpositionTable.h"
+
+// Thinks on the opponent's time: after our move, the position after the reply we expect is searched on a
+// background thread. If the opponent plays that reply (a ponder hit), the search carries on as our real
+// search and only gets the time left of our move's budget; otherwise it is stopped, leaving what it found
+// in the shared transposition table.
+class Ponderer {
+    public:
+        Ponderer(TranspositionTable& transpositionTable, std::vector<std::unique_ptr<PawnTable>>& pawnTables); //CTOR, see ParallelSearch
+        ~Ponderer(); //DTOR, stops pondering
+
+        //ponders the position after reply is played on board (a copy is taken), stopping any earlier ponder first
+        void start(const Board& board, Move reply, const Search::Limits& limits, int threads, const Search::Options& options);
+        //the opponent moved to the position with key: on a hit, lets the search run until it finishes or moveTimeMs
+        //have passed since pondering started (0 waits for it to finish) and returns its move; on a miss stops
+        //pondering and returns null
+        Move ponderHit(Key key, int64_t moveTimeMs);
+        void stop();
+        bool isPondering() const;
+        const SearchStats& getStats() const; //of the last ponder search, once stopped
+
+    private:
+        TranspositionTable& transpositionTable;
+        std::vector<std::unique_ptr<PawnTable>>& pawnTables;
+        std::atomic<bool> stopSignal;
+        std::unique_ptr<Board> board; //the pondered position, owned here since the search thread works on it
+        std::unique_ptr<ParallelSearch> search;
+        std::thread thread;
+        std::atomic<bool> finished; //set by the search thread when its own limits end the search
+        Move bestMove; //written by the search thread, read once it is joined
+        SearchStats stats;
+        Key key;
+        std::chrono::steady_clock::time_point startTime; //when pondering started, our move's budget runs from here
+};
+
+#endif
@@ -0,0 +1,547 @@
+#include "search.h"
+#include "../model/board.h"
+#include "../shared/colour.h"
+
+namespace {
+    const int DEFAULT_MOVES_TO_GO = 30; //assumed moves left when the clock does not say
+    const int64_t CLOCK_MARGIN_MS = 50; //kept back for move overhead so the flag never falls
+    const uint64_t CLOCK_CHECK_INTERVAL = 1024; //nodes between clock reads
+    const int DELTA_MARGIN = 200; //a capture must be able to lift the score to within this of alpha to be searched
+
+    const int NULL_MOVE_MIN_DEPTH = 3;
+    const int FUTILITY_MAX_DEPTH = 3;
+    const int FUTILITY_MARGINS[FUTILITY_MAX_DEPTH + 1] = {0, 200, 300, 500}; //by remaining depth
+    const int LMR_MIN_DEPTH = 3;
+    const int LMR_MIN_INDEX = 3; //the table move, captures and killers normally come first and are never reduced
+    const int LMR_GOOD_HISTORY = 4096; //quiet moves that have caused this many cutoffs are reduced a ply less
+
+    const int ASPIRATION_MIN_DEPTH = 4; //shallower iterations are cheap and their scores still swing a lot
+    const int ASPIRATION_WINDOW = 50; //centipawns either side of the previous iteration's score (which swings between odd and even depths)
+    const int ASPIRATION_MAX_WINDOW = 800; //a window that fails wider than this opens fully on that side
+
+    const int MAX_EVALUATION = Search::MATE - Search::MAX_PLY - 1; //static scores stay below every mate score
+
+    int nullMoveReduction(int depth) {
+        return depth >= 7 ? 3 : 2;
+    }
+
+    int lateMoveReduction(int depth, int index, int historyScore) {
+        int reduction = 1;
+        if (index >= 6 && depth >= 6) {
+            ++reduction;
+        }
+        if (index >= 12 && depth >= 9) {
+            ++reduction;
+        }
+        if (historyScore >= LMR_GOOD_HISTORY) {
+            --reduction;
+        }
+        return reduction < depth - 2 ? reduction : depth - 2; //the reduced search keeps at least one full ply
+    }
+}
+
+Search::Search(Board& board, TranspositionTable& transpositionTable, const std::atomic<bool>* stopSignal, PawnTable* pawnTable):
+    board{board}, transpositionTable{transpositionTable}, ownPawnTable{pawnTable ? nullptr : new PawnTable},
+    pawnTable{pawnTable ? pawnTable : ownPawnTable.get()}, pawnProbesBefore{0}, pawnHitsBefore{0},
+    stopSignal{stopSignal}, stopped{false}, score{0}, completedDepth{0} {
+        pvLength[0] = 0;
+    }
+
+Search::Limits Search::Limits::forClock(int64_t remainingMs, int64_t incrementMs, int movesToGo) {
+    if (movesToGo <= 0) {
+        movesToGo = DEFAULT_MOVES_TO_GO;
+    }
+
+    //an even share of the remaining time plus most of the increment, but never more than half the clock
+    int64_t budget = remainingMs / movesToGo + incrementMs * 3 / 4;
+    int64_t cap = remainingMs / 2 - CLOCK_MARGIN_MS;
+    if (budget > cap) {
+        budget = cap;
+    }
+
+    Limits limits;
+    limits.moveTimeMs = budget > 1 ? budget : 1;
+    return limits;
+}
+
+int Search::getScore() const {
+    return score;
+}
+
+int Search::getDepth() const {
+    return completedDepth;
+}
+
+uint64_t Search::getNodes() const {
+    return stats.nodes;
+}
+
+const SearchStats& Search::getStats() const {
+    return stats;
+}
+
+void Search::setReporter(std::function<void(const SearchStats&)> reporter) {
+    this->reporter = reporter;
+}
+
+void Search::setOptions(const Options& options) {
+    this->options = options;
+}
+
+const Search::Options& Search::getOptions() const {
+    return options;
+}
+
+bool Search::isMateScore(int score) {
+    return score >= MATE - MAX_PLY || score <= -(MATE - MAX_PLY);
+}
+
+int Search::evaluate() {
+    if (options.evaluator == Evaluator::Neural && board.getNetwork()) {
+        //a network's output has no natural bound, and a score in the mate range would end the search
+        int score = board.getNetwork()->evaluate(board.getAccumulator(), board.getSideToMove());
+        return score > MAX_EVALUATION ? MAX_EVALUATION : (score < -MAX_EVALUATION ? -MAX_EVALUATION : score);
+    }
+
+    //the board keeps the piece-square terms summed and the pawn structure is usually cached,
+    //so this is mostly the blend of the middlegame and endgame scores by phase
+    const PawnTable::Entry& pawns = pawnTable->probe(board);
+    int middlegame = board.getMiddlegameScore() + pawns.middlegame;
+    int endgame = board.getEndgameScore() + pawns.endgame;
+
+    int phase = board.getPhase() < PieceSquare::MAX_PHASE ? board.getPhase() : PieceSquare::MAX_PHASE;
+    int score = (middlegame * phase + endgame * (PieceSquare::MAX_PHASE - phase)) / PieceSquare::MAX_PHASE;
+    return board.getSideToMove() == Colour::White ? score : -score;
+}
+
+int Search::scoreToTable(int score, int ply) {
+    //mate scores are stored relative to the stored position, not the root it was first reached from
+    if (score >= MATE - MAX_PLY) {
+        return score + ply;
+    }
+    if (score <= -(MATE - MAX_PLY)) {
+        return score - ply;
+    }
+    return score;
+}
+
+int Search::scoreFromTable(int score, int ply) {
+    if (score >= MATE - MAX_PLY) {
+        return score - ply;
+    }
+    if (score <= -(MATE - MAX_PLY)) {
+        return score + ply;
+    }
+    return score;
+}
+
+int64_t Search::elapsedMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void Search::checkLimits() {
+    if (stopSignal && stopSignal->load(std::memory_order_relaxed)) {
+        stopped = true;
+        return;
+    }
+    if (completedDepth == 0) { //the first iteration always completes so there is a move to play
+        return;
+    }
+    if ((limits.nodes && stats.nodes >= limits.nodes)
+        || (limits.moveTimeMs && stats.nodes % CLOCK_CHECK_INTERVAL == 0 && elapsedMs() >= limits.moveTimeMs)) {
+        stopped = true;
+    }
+}
+
+Move Search::think(const Limits& searchLimits, int firstDepth) {
+    limits = searchLimits;
+    startTime = std::chrono::steady_clock::now();
+    stopped = false;
+    stats.clear();
+    pawnProbesBefore = pawnTable->getProbes();
+    pawnHitsBefore = pawnTable->getHits();
+    completedDepth = 0;
+    score = 0;
+    moveOrderer.clear();
+
+    MoveList moves = board.generateLegalMoves(board.getSideToMove());
+    if (moves.empty()) {
+        return Move{};
+    }
+    //a stored best move (from an earlier search of this position, e.g. while pondering) is searched first
+    TranspositionTable::Entry entry;
+    moveOrderer.score(moves, board, transpositionTable.probe(board.getKey(), entry) ? entry.move : Move{}, 0);
+    moves.sort(); //later iterations keep this order, apart from moving the best move to the front
+
+    for (int iteration = firstDepth; iteration <= limits.depth && iteration < MAX_PLY; iteration++) {
+        uint64_t nodesBefore = stats.nodes;
+
+        //expect this iteration's score near the last one; if it falls outside, widen that side and search again
+        int alpha = -INFINITE_SCORE;
+        int beta = INFINITE_SCORE;
+        int window = ASPIRATION_WINDOW;
+        if (iteration >= ASPIRATION_MIN_DEPTH && completedDepth > 0 && !isMateScore(score)) {
+            alpha = score - window;
+            beta = score + window;
+        }
+        int iterationScore;
+        while (true) {
+            iterationScore = searchRoot(moves, iteration, alpha, beta);
+            if (stopped) {
+                break;
+            }
+            window *= 2;
+            if (iterationScore <= alpha) {
+                alpha = window > ASPIRATION_MAX_WINDOW ? -INFINITE_SCORE : iterationScore - window;
+            }
+            else if (iterationScore >= beta) {
+                beta = window > ASPIRATION_MAX_WINDOW ? INFINITE_SCORE : iterationScore + window;
+            }
+            else {
+                break;
+            }
+        }
+        if (stopped) {
+            break; //a partial iteration is not trusted, the last completed one stands
+        }
+        score = iterationScore;
+        completedDepth = iteration;
+        stats.previousIterationNodes = stats.iterationNodes;
+        stats.iterationNodes = stats.nodes - nodesBefore;
+        stats.depth = completedDepth;
+        stats.score = score;
+        stats.elapsedMs = elapsedMs();
+        stats.principalVariation.assign(pvTable[0], pvTable[0] + pvLength[0]);
+        stats.pawnProbes = pawnTable->getProbes() - pawnProbesBefore;
+        stats.pawnHits = pawnTable->getHits() - pawnHitsBefore;
+        if (reporter) {
+            reporter(stats);
+        }
+
+        if (isMateScore(score)) {
+            break; //deeper iterations cannot find a shorter mate
+        }
+        //the next iteration usually takes several times longer than this one, so don't start what can't finish
+        if (limits.moveTimeMs && elapsedMs() >= limits.moveTimeMs / 2) {
+            break;
+        }
+    }
+
+    stats.elapsedMs = elapsedMs();
+    stats.pawnProbes = pawnTable->getProbes() - pawnProbesBefore;
+    stats.pawnHits = pawnTable->getHits() - pawnHitsBefore;
+    return moves[0];
+}
+
+int Search::searchRoot(MoveList& moves, int depth, int alpha, int beta) {
+    //the previous iteration's best move is first, which gives alpha-beta a good bound early
+    pvLength[0] = 0;
+    int originalAlpha = alpha;
+    int best = -INFINITE_SCORE;
+    int bestIndex = 0;
+    for (int i = 0; i < moves.size(); i++) {
+        board.makeMove(moves[i]);
+        transpositionTable.prefetch(board.getKey());
+        int moveScore;
+        if (i == 0) {
+            moveScore = -negamax(depth - 1, 1, -beta, -alpha);
+        }
+        else {
+            moveScore = -negamax(depth - 1, 1, -alpha - 1, -alpha);
+            if (!stopped && moveScore > alpha && moveScore < beta) {
+                moveScore = -negamax(depth - 1, 1, -beta, -alpha);
+            }
+        }
+        board.unmakeMove();
+
+        if (stopped) {
+            return 0;
+        }
+        if (moveScore > best) {
+            best = moveScore;
+            if (moveScore > alpha) {
+                alpha = moveScore;
+                bestIndex = i;
+                updatePrincipalVariation(0, moves[i]);
+            }
+            if (alpha >= beta) {
+                break; //fails high, the caller widens the window
+            }
+        }
+    }
+
+    //a fail low proves nothing about which move is best, so the order is kept for the re-search
+    if (best > originalAlpha) {
+        Move bestMove = moves[bestIndex];
+        for (int i = bestIndex; i > 0; i--) {
+            moves[i] = moves[i - 1];
+        }
+        moves[0] = bestMove;
+    }
+    TranspositionTable::Bound bound = best >= beta ? TranspositionTable::Lower
+        : (best > originalAlpha ? TranspositionTable::Exact : TranspositionTable::Upper);
+    transpositionTable.store(board.getKey(), bound == TranspositionTable::Upper ? Move{} : moves[0], scoreToTable(best, 0), depth, bound);
+    return best;
+}
+
+void Search::updatePrincipalVariation(int ply, Move move) {
+    pvTable[ply][0] = move;
+    int childLength = ply < MAX_PLY ? pvLength[ply + 1] : 0;
+    for (int i = 0; i < childLength; i++) {
+        pvTable[ply][i + 1] = pvTable[ply + 1][i];
+    }
+    pvLength[ply] = childLength + 1;
+}
+
+int Search::negamax(int depth, int ply, int alpha, int beta, bool nullMoveAllowed) {
+    ++stats.nodes;
+    pvLength[ply] = 0;
+    if (ply > stats.selectiveDepth) {
+        stats.selectiveDepth = ply;
+    }
+    checkLimits();
+    if (stopped) {
+        return 0;
+    }
+
+    if (board.getHalfmoveClock() >= 100) { //fifty-move rule
+        return 0;
+    }
+
+    //with three pieces or fewer the tablebase knows the exact result, no subtree needs searching
+    Tablebase::Result tablebaseResult;
+    if (board.getTablebase() && Bitboards::popCount(board.getOccupied()) <= 3 && board.getTablebase()->probe(board, tablebaseResult)) {
+        ++stats.tablebaseHits;
+        int matePly = ply + tablebaseResult.pliesToMate;
+        if (matePly >= MAX_PLY) {
+            matePly = MAX_PLY - 1; //a mate too far off for the search still has to score inside the mate band
+        }
+        switch (tablebaseResult.wdl) {
+            case Tablebase::Wdl::Win: return MATE - matePly;
+            case Tablebase::Wdl::Loss: return -(MATE - matePly);
+            default: return 0;
+        }
+    }
+
+    if (depth <= 0) {
+        return quiescence(ply, alpha, beta);
+    }
+    if (ply >= MAX_PLY) {
+        return evaluate();
+    }
+    bool inCheck = board.isInCheck();
+    bool pvNode = beta - alpha > 1; //only the first line of each node is searched with an open window
+
+    //a stored result at least as deep as this search either answers it outright or gives the move to try first;
+    //not on the principal variation, which would be cut short where the table answered
+    Key key = board.getKey();
+    Move tableMove{};
+    TranspositionTable::Entry entry;
+    ++stats.tableProbes;
+    if (transpositionTable.probe(key, entry)) {
+        ++stats.tableHits;
+        tableMove = entry.move;
+        int tableScore = scoreFromTable(entry.score, ply);
+        if (!pvNode && entry.depth >= depth
+            && (entry.bound == TranspositionTable::Exact
+                || (entry.bound == TranspositionTable::Lower && tableScore >= beta)
+                || (entry.bound == TranspositionTable::Upper && tableScore <= alpha))) {
+            return tableScore;
+        }
+    }
+
+    //pruning is never tried in check (the evasions must all be seen for mate), near mate scores or on the
+    //principal variation, whose line and score are reported
+    int staticEval = inCheck ? 0 : evaluate();
+    bool betaIsMate = isMateScore(beta);
+
+    //reverse futility: so far above beta that a quiet move in the last few plies won't bring it back
+    if (options.futility && !pvNode && !inCheck && !betaIsMate && depth <= FUTILITY_MAX_DEPTH && staticEval - FUTILITY_MARGINS[depth] >= beta) {
+        return staticEval;
+    }
+
+    //null move: if passing still leaves us at or above beta after a reduced search, a real move will too.
+    //Not with only pawns left, where having to move is often the whole problem (zugzwang)
+    if (options.nullMove && nullMoveAllowed && !pvNode && !inCheck && !betaIsMate && depth >= NULL_MOVE_MIN_DEPTH
+        && staticEval >= beta && board.hasNonPawnMaterial(board.getSideToMove())) {
+        board.makeNullMove();
+        int nullScore = -negamax(depth - 1 - nullMoveReduction(depth), ply + 1, -beta, -beta + 1, false);
+        board.unmakeMove();
+        if (stopped) {
+            return 0;
+        }
+        if (nullScore >= beta) {
+            return isMateScore(nullScore) ? beta : nullScore; //a mate found without moving is not proven
+        }
+    }
+
+    MoveList moves = board.generateLegalMoves(board.getSideToMove());
+    if (moves.empty()) {
+        return inCheck ? -(MATE - ply) : 0; //checkmate or stalemate
+    }
+
+    moveOrderer.score(moves, board, tableMove, ply);
+
+    //futility: this far below alpha only captures, promotions and checks can help in the last few plies
+    bool futile = options.futility && !pvNode && !inCheck && !isMateScore(alpha) && depth <= FUTILITY_MAX_DEPTH
+        && staticEval + FUTILITY_MARGINS[depth] <= alpha;
+
+    int originalAlpha = alpha;
+    int best = -INFINITE_SCORE;
+    Move bestMove{};
+    int searched = 0;
+    for (int i = 0; i < moves.size(); i++) {
+        Move move = moves.pickNext(i); //most lists are cut off after a few moves, so sorting them all would be wasted
+        int orderScore = moves.scoreAt(i);
+        bool quiet = !move.isCapture() && !move.isPromotion();
+
+        board.makeMove(move);
+        bool givesCheck = board.isInCheck();
+        if (futile && quiet && !givesCheck) {
+            board.unmakeMove();
+            if (staticEval + FUTILITY_MARGINS[depth] > best) {
+                best = staticEval + FUTILITY_MARGINS[depth]; //upper bound for the pruned move
+            }
+            continue;
+        }
+        transpositionTable.prefetch(board.getKey());
+
+        //the first move gets the full window; the rest are expected to fail low, so a null window search
+        //proves it (reduced for late quiet moves) and they are searched properly only if they don't
+        int moveScore;
+        if (searched++ == 0) {
+            moveScore = -negamax(depth - 1, ply + 1, -beta, -alpha);
+        }
+        else {
+            int reduction = 0;
+            if (options.lateMoveReductions && quiet && !inCheck && !givesCheck && depth >= LMR_MIN_DEPTH && i >= LMR_MIN_INDEX
+                && MoveOrderer::isHistoryScore(orderScore)) {
+                reduction = lateMoveReduction(depth, i, orderScore);
+            }
+            moveScore = -negamax(depth - 1 - reduction, ply + 1, -alpha - 1, -alpha);
+            if (!stopped && reduction > 0 && moveScore > alpha) {
+                moveScore = -negamax(depth - 1, ply + 1, -alpha - 1, -alpha);
+            }
+            if (!stopped && moveScore > alpha && moveScore < beta) {
+                moveScore = -negamax(depth - 1, ply + 1, -beta, -alpha);
+            }
+        }
+        board.unmakeMove();
+        if (stopped) {
+            return 0;
+        }
+
+        if (moveScore > best) {
+            best = moveScore;
+            bestMove = move;
+            if (moveScore > alpha) {
+                alpha = moveScore;
+                updatePrincipalVariation(ply, move);
+            }
+            if (alpha >= beta) {
+                ++stats.betaCutoffs;
+                if (i == 0) {
+                    ++stats.firstMoveCutoffs;
+                }
+                moveOrderer.updateCutoff(board.getSideToMove(), move, ply, depth);
+                break; //the opponent will avoid this position, no need to look further
+            }
+        }
+    }
+
+    TranspositionTable::Bound bound = best >= beta ? TranspositionTable::Lower
+        : (best > originalAlpha ? TranspositionTable::Exact : TranspositionTable::Upper);
+    transpositionTable.store(key, bound == TranspositionTable::Upper ? Move{} : bestMove, scoreToTable(best, ply), depth, bound);
+    return best;
+}
+
+int Search::pieceValue(Piece::PieceType type) {
+    return Piece::valueOf(type) * 100;
+}
+
+int Search::quiescence(int ply, int alpha, int beta) {
+    ++stats.nodes;
+    pvLength[ply] = 0; //the principal variation ends where the captures begin
+    ++stats.quiescenceNodes;
+    if (ply > stats.selectiveDepth) {
+        stats.selectiveDepth = ply;
+    }
+    checkLimits();
+    if (stopped) {
+        return 0;
+    }
+    if (ply >= MAX_PLY) {
+        return evaluate();
+    }
+
+    //in check every evasion is searched (and mate is seen), otherwise only captures and promotions
+    bool inCheck = board.isInCheck();
+    int best = -INFINITE_SCORE;
+    int standPat = 0;
+    MoveList moves;
+    if (inCheck) {
+        moves = board.generateLegalMoves(board.getSideToMove());
+        if (moves.empty()) {
+            return -(MATE - ply);
+        }
+    }
+    else {
+        //stand pat: the side to move is assumed to have a quiet move at least as good as the static evaluation
+        standPat = evaluate();
+        if (standPat >= beta) {
+            return standPat;
+        }
+        if (standPat + pieceValue(Piece::PieceType::Queen) + DELTA_MARGIN < alpha) {
+            return standPat; //not even winning a queen would help
+        }
+        if (standPat > alpha) {
+            alpha = standPat;
+        }
+        best = standPat;
+        moves = board.generateCaptures(board.getSideToMove());
+    }
+
+    moveOrderer.score(moves, board, Move{}, ply);
+    for (int i = 0; i < moves.size(); i++) {
+        Move move = moves.pickNext(i);
+
+        if (!inCheck) {
+            if (move.isPromotion() && move.promotionType() != Piece::PieceType::Queen) {
+                continue; //underpromotions only matter in rare positions, leave them to the main search
+            }
+
+            //delta pruning: skip captures that can't bring the score back up to alpha
+            int gain = 0;
+            if (move.isEnPassant()) {
+                gain = pieceValue(Piece::PieceType::Pawn);
+            }
+            else if (move.isCapture()) {
+                gain = pieceValue(board.getPieceTypeAt(move.to()));
+            }
+            if (move.isPromotion()) {
+                gain += pieceValue(Piece::PieceType::Queen) - pieceValue(Piece::PieceType::Pawn);
+            }
+            if (standPat + gain + DELTA_MARGIN < alpha) {
+                continue;
+            }
+        }
+
+        board.makeMove(move);
+        int moveScore = -quiescence(ply + 1, -beta, -alpha);
+        board.unmakeMove();
+        if (stopped) {
+            return 0;
+        }
+
+        if (moveScore > best) {
+            best = moveScore;
+            if (moveScore > alpha) {
+                alpha = moveScore;
+            }
+            if (alpha >= beta) {
+                break;
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,103 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "../model/move.h"
+#include "../model/moveList.h"
+#include "./moveOrderer.h"
+#include "./pawnTable.h"
+#include "./searchStats.h"
+#include "./transpositionTable.h"
+class Board;
+
+// Negamax alpha-beta search. Scores are from the side to move's point of view, in centipawns;
+// a mate found n plies from the root scores MATE - n (or -(MATE - n) when being mated),
+// so shorter mates are preferred and longer defences are chosen when lost.
+// Principal variation search: only the first move of a node gets the full window, the rest are
+// searched with a null window to prove they are no better and re-searched only if they are. Each
+// iteration starts from a narrow aspiration window around the previous score, widened on failure,
+// and keeps the expected line (the principal variation) in a triangular table.
+class Search {
+    public:
+        static const int MATE = 32000;
+        static const int INFINITE_SCORE = MATE + 1;
+        static const int MAX_PLY = MoveOrderer::MAX_PLY; //one limit for the search and the orderer's per-ply killer slots
+
+        struct Limits { //0 means unlimited, the search always finishes at least depth 1
+            int depth = MAX_PLY;
+            int64_t moveTimeMs = 0;
+            uint64_t nodes = 0;
+
+            //budget for one move when remainingMs are left on our clock and incrementMs are added after each move,
+            //movesToGo is the number of moves until the next time control (0 for the rest of the game)
+            static Limits forClock(int64_t remainingMs, int64_t incrementMs, int movesToGo = 0);
+        };
+
+        enum class Evaluator {
+            Classical, //material, piece-square tables and pawn structure
+            Neural //the board's NNUE network, Classical is used when the board has none
+        };
+
+        struct Options { //selective search, each technique can be switched off on its own to measure what it is worth
+            bool nullMove = true; //skip our turn and prune if the opponent still can't get below beta
+            bool lateMoveReductions = true; //search quiet moves ordered late to a reduced depth first
+            bool futility = true; //reverse futility and futility pruning in the last plies
+            Evaluator evaluator = Evaluator::Classical;
+        };
+
+        //searches by making and unmaking moves on board, which is left as it was;
+        //the search also stops (without a result for the current iteration) once stopSignal is set;
+        //pawnTable, if given, is kept by the caller so later searches find the structures scored by this one
+        Search(Board& board, TranspositionTable& transpositionTable, const std::atomic<bool>* stopSignal = nullptr,
+               PawnTable* pawnTable = nullptr);
+
+        //iterative deepening from firstDepth, null move if the side to move has no legal moves;
+        //the caller starts a new table generation (TranspositionTable::newSearch) since the table may be shared
+        Move think(const Limits& limits, int firstDepth = 1);
+        int getScore() const; //score of the move returned by the last think
+        int getDepth() const; //deepest fully searched iteration of the last think
+        uint64_t getNodes() const;
+        const SearchStats& getStats() const; //counters of the last think, with its principal variation
+        void setReporter(std::function<void(const SearchStats&)> reporter); //called after every completed iteration, nothing by default
+        void setOptions(const Options& options);
+        const Options& getOptions() const;
+
+        static bool isMateScore(int score);
+        int evaluate(); //static evaluation of the board for the side to move
+
+    private:
+        Board& board;
+        TranspositionTable& transpositionTable;
+        MoveOrderer moveOrderer;
+        std::unique_ptr<PawnTable> ownPawnTable; //when the caller gave none
+        PawnTable* pawnTable;
+        uint64_t pawnProbesBefore; //the table's counters when this think started
+        uint64_t pawnHitsBefore;
+        const std::atomic<bool>* stopSignal;
+        Options options;
+        Limits limits;
+        std::chrono::steady_clock::time_point startTime;
+        bool stopped; //set once a limit is hit, every search call then unwinds without a result
+        int score;
+        int completedDepth;
+        SearchStats stats;
+        std::function<void(const SearchStats&)> reporter;
+        Move pvTable[MAX_PLY + 1][MAX_PLY + 1]; //pvTable[ply] is the best line found from ply on, pvLength[ply] moves long
+        int pvLength[MAX_PLY + 1];
+
+        static int scoreToTable(int score, int ply);
+        static int scoreFromTable(int score, int ply);
+        int64_t elapsedMs() const;
+        void checkLimits();
+        int searchRoot(MoveList& moves, int depth, int alpha, int beta); //searches the root moves, the best is moved to the front
+        void updatePrincipalVariation(int ply, Move move); //move followed by the line found below it
+        int negamax(int depth, int ply, int alpha, int beta, bool nullMoveAllowed = true); //no null move right after another
+        int quiescence(int ply, int alpha, int beta); //resolves captures (and checks) at the horizon before evaluating
+        static int pieceValue(Piece::PieceType type); //centipawns
+};
+
+#endif
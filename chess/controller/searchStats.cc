@@ -0,0 +1,110 @@
+#include <iomanip>
+#include <sstream>
+#include "searchStats.h"
+#include "search.h"
+
+namespace {
+    //"cp 35", or "mate 3" / "mate -3" in moves when a mate was found
+    std::string scoreText(int score) {
+        std::ostringstream text;
+        if (Search::isMateScore(score)) {
+            int plies = Search::MATE - (score > 0 ? score : -score);
+            text << "mate " << (score > 0 ? (plies + 1) / 2 : -(plies / 2));
+        }
+        else {
+            text << "cp " << score;
+        }
+        return text.str();
+    }
+}
+
+SearchStats::SearchStats() {
+    clear();
+}
+
+void SearchStats::clear() {
+    depth = 0;
+    selectiveDepth = 0;
+    score = 0;
+    nodes = 0;
+    quiescenceNodes = 0;
+    tableProbes = 0;
+    tableHits = 0;
+    tablebaseHits = 0;
+    pawnProbes = 0;
+    pawnHits = 0;
+    betaCutoffs = 0;
+    firstMoveCutoffs = 0;
+    iterationNodes = 0;
+    previousIterationNodes = 0;
+    elapsedMs = 0;
+    principalVariation.clear();
+}
+
+void SearchStats::add(const SearchStats& other) {
+    selectiveDepth = other.selectiveDepth > selectiveDepth ? other.selectiveDepth : selectiveDepth;
+    nodes += other.nodes;
+    quiescenceNodes += other.quiescenceNodes;
+    tableProbes += other.tableProbes;
+    tableHits += other.tableHits;
+    tablebaseHits += other.tablebaseHits;
+    pawnProbes += other.pawnProbes;
+    pawnHits += other.pawnHits;
+    betaCutoffs += other.betaCutoffs;
+    firstMoveCutoffs += other.firstMoveCutoffs;
+}
+
+uint64_t SearchStats::nodesPerSecond() const {
+    return nodes * 1000 / static_cast<uint64_t>(elapsedMs > 0 ? elapsedMs : 1);
+}
+
+double SearchStats::tableHitRate() const {
+    return tableProbes ? static_cast<double>(tableHits) / tableProbes : 0.0;
+}
+
+double SearchStats::pawnHitRate() const {
+    return pawnProbes ? static_cast<double>(pawnHits) / pawnProbes : 0.0;
+}
+
+double SearchStats::firstMoveCutoffRate() const {
+    return betaCutoffs ? static_cast<double>(firstMoveCutoffs) / betaCutoffs : 0.0;
+}
+
+double SearchStats::branchingFactor() const {
+    return previousIterationNodes ? static_cast<double>(iterationNodes) / previousIterationNodes : 0.0;
+}
+
+std::string SearchStats::toLine() const {
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1)
+         << "info depth " << depth << " seldepth " << selectiveDepth << " score " << scoreText(score)
+         << " nodes " << nodes << " qnodes " << quiescenceNodes << " nps " << nodesPerSecond() << " time " << elapsedMs
+         << " tthits " << tableHitRate() * 100 << "% tbhits " << tablebaseHits << " pawnhits " << pawnHitRate() * 100 << "%"
+         << " firstcutoffs " << firstMoveCutoffRate() * 100 << "%" << std::setprecision(2) << " ebf " << branchingFactor();
+    if (!principalVariation.empty()) {
+        line << " pv";
+        for (Move move : principalVariation) {
+            line << " " << move.toString();
+        }
+    }
+    return line.str();
+}
+
+std::string SearchStats::toJson() const {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(4)
+         << "{\"depth\":" << depth << ",\"seldepth\":" << selectiveDepth << ",\"score\":" << score
+         << ",\"mate\":" << (Search::isMateScore(score) ? "true" : "false")
+         << ",\"nodes\":" << nodes << ",\"qnodes\":" << quiescenceNodes << ",\"nps\":" << nodesPerSecond()
+         << ",\"timeMs\":" << elapsedMs << ",\"ttProbes\":" << tableProbes << ",\"ttHits\":" << tableHits
+         << ",\"ttHitRate\":" << tableHitRate() << ",\"tbHits\":" << tablebaseHits
+         << ",\"pawnProbes\":" << pawnProbes << ",\"pawnHits\":" << pawnHits << ",\"pawnHitRate\":" << pawnHitRate()
+         << ",\"betaCutoffs\":" << betaCutoffs
+         << ",\"firstMoveCutoffs\":" << firstMoveCutoffs << ",\"firstMoveCutoffRate\":" << firstMoveCutoffRate()
+         << ",\"branchingFactor\":" << branchingFactor() << ",\"pv\":[";
+    for (int i = 0; i < principalVariation.size(); i++) {
+        json << (i ? ",\"" : "\"") << principalVariation[i].toString() << "\"";
+    }
+    json << "]}";
+    return json.str();
+}
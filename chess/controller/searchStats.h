@@ -0,0 +1,46 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../model/move.h"
+
+// What one search did, counted by Search as it goes and summed over the threads by ParallelSearch.
+// Printed as a single info line (toLine) for people, or as a JSON object (toJson) for scripts that
+// track the numbers across versions.
+class SearchStats {
+    public:
+        int depth; //last completed iteration
+        int selectiveDepth; //deepest ply reached, quiescence included
+        int score; //centipawns (or a Search::MATE score) for the side to move
+        uint64_t nodes; //every negamax and quiescence call
+        uint64_t quiescenceNodes;
+        uint64_t tableProbes; //transposition table lookups in negamax
+        uint64_t tableHits;
+        uint64_t tablebaseHits;
+        uint64_t pawnProbes; //pawn structure lookups by the evaluation
+        uint64_t pawnHits;
+        uint64_t betaCutoffs;
+        uint64_t firstMoveCutoffs; //beta cutoffs by the first move searched, a measure of move ordering
+        uint64_t iterationNodes; //nodes of the last completed iteration
+        uint64_t previousIterationNodes; //and of the one before, for the branching factor
+        int64_t elapsedMs;
+        std::vector<Move> principalVariation; //the line the last completed iteration expects, best move first
+
+        SearchStats(); //CTOR, everything zero
+
+        void clear();
+        void add(const SearchStats& other); //sums the counters, keeping this search's depth, score, time and line
+
+        uint64_t nodesPerSecond() const;
+        double tableHitRate() const; //0 to 1
+        double pawnHitRate() const; //0 to 1
+        double firstMoveCutoffRate() const; //0 to 1
+        double branchingFactor() const; //nodes of the last iteration over the one before, 0 before the second iteration
+
+        std::string toLine() const; //"info depth 9 seldepth 21 score cp 35 nodes ... pv e2e4 e7e5" on one line
+        std::string toJson() const; //the same fields as a single line JSON object
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "transpositionTable.h"
+#include <new>
+
+// data layout: move (bits 0-15), score (16-31), depth (32-39), bound (40-41), generation (48-55)
+namespace {
+    Move dataMove(uint64_t data) { return Move::fromRaw(static_cast<uint16_t>(data)); }
+    int dataScore(uint64_t data) { return static_cast<int16_t>(data >> 16); }
+    int dataDepth(uint64_t data) { return static_cast<uint8_t>(data >> 32); }
+    TranspositionTable::Bound dataBound(uint64_t data) { return static_cast<TranspositionTable::Bound>((data >> 40) & 3); }
+    uint8_t dataGeneration(uint64_t data) { return static_cast<uint8_t>(data >> 48); }
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes): buckets{nullptr}, bucketMask{0}, generation{0} {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) {
+        count *= 2;
+    }
+
+    memory.reset(new char[count * sizeof(Bucket) + alignof(Bucket) - 1]);
+    uintptr_t address = reinterpret_cast<uintptr_t>(memory.get());
+    buckets = reinterpret_cast<Bucket*>((address + alignof(Bucket) - 1) & ~static_cast<uintptr_t>(alignof(Bucket) - 1));
+    for (size_t i = 0; i < count; i++) {
+        new (&buckets[i]) Bucket;
+    }
+    bucketMask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (uint64_t i = 0; i <= bucketMask; i++) {
+        for (Slot& slot : buckets[i].slots) {
+            slot.keyXorData.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+    ++generation;
+}
+
+size_t TranspositionTable::getSizeMB() const {
+    return (bucketMask + 1) * sizeof(Bucket) / (1024 * 1024);
+}
+
+uint64_t TranspositionTable::pack(Move move, int score, int depth, Bound bound, uint8_t generation) {
+    return static_cast<uint64_t>(move.raw())
+        | static_cast<uint64_t>(static_cast<uint16_t>(score)) << 16
+        | static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 32
+        | static_cast<uint64_t>(bound) << 40
+        | static_cast<uint64_t>(generation) << 48;
+}
+
+bool TranspositionTable::probe(Key key, Entry& entry) const {
+    const Bucket& bucket = buckets[key & bucketMask];
+    for (const Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.keyXorData.load(std::memory_order_relaxed) ^ data) == key && dataBound(data) != None) {
+            entry = Entry{dataMove(data), dataScore(data), dataDepth(data), dataBound(data)};
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(Key key, Move move, int score, int depth, Bound bound) {
+    Bucket& bucket = buckets[key & bucketMask];
+
+    //reuse this position's slot if it has one, otherwise evict the shallowest entry, counting older searches as shallower
+    Slot* replace = &bucket.slots[0];
+    int replaceWorth = 1 << 30;
+    for (Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.keyXorData.load(std::memory_order_relaxed) ^ data) == key) {
+            if (move.isNull()) { //keep the best move of an earlier search of this position
+                move = dataMove(data);
+            }
+            replace = &slot;
+            break;
+        }
+
+        int age = static_cast<uint8_t>(generation - dataGeneration(data));
+        int worth = dataBound(data) == None ? -(1 << 30) : dataDepth(data) - 8 * age;
+        if (worth < replaceWorth) {
+            replaceWorth = worth;
+            replace = &slot;
+        }
+    }
+
+    if (depth < 0) {
+        depth = 0;
+    }
+    uint64_t data = pack(move, score, depth, bound, generation);
+    replace->keyXorData.store(key ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
@@ -0,0 +1,67 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "../model/move.h"
+#include "../model/zobrist.h"
+
+// Fixed-size hash table of search results keyed by Zobrist key, shared between search threads without locks.
+// Each entry is two 64-bit words, key ^ data and data: a reader only accepts an entry when the two words
+// xor back to its key, so an entry torn by a concurrent write is simply treated as a miss.
+class TranspositionTable {
+    public:
+        enum Bound { //how the stored score relates to the true score
+            None = 0,
+            Upper = 1, //failed low, true score <= score
+            Lower = 2, //failed high, true score >= score
+            Exact = 3
+        };
+
+        struct Entry {
+            Move move;
+            int score;
+            int depth;
+            Bound bound;
+        };
+
+        static const size_t DEFAULT_SIZE_MB = 16;
+
+        TranspositionTable(size_t megabytes = DEFAULT_SIZE_MB); //rounded down to a power of two number of buckets
+        TranspositionTable(const TranspositionTable& other) = delete;
+        TranspositionTable& operator=(const TranspositionTable& other) = delete;
+
+        void resize(size_t megabytes); //also clears, must not race with searches
+        void clear();
+        void newSearch(); //entries from earlier searches become preferred for replacement
+        size_t getSizeMB() const;
+
+        bool probe(Key key, Entry& entry) const;
+        void store(Key key, Move move, int score, int depth, Bound bound);
+        void prefetch(Key key) const { //pulls the bucket into cache ahead of the probe
+            __builtin_prefetch(&buckets[key & bucketMask]);
+        }
+
+    private:
+        static const int BUCKET_SIZE = 4;
+
+        struct Slot {
+            std::atomic<uint64_t> keyXorData;
+            std::atomic<uint64_t> data;
+        };
+
+        struct alignas(64) Bucket { //one cache line
+            Slot slots[BUCKET_SIZE];
+        };
+
+        std::unique_ptr<char[]> memory; //over-allocated so the buckets can start on a cache line
+        Bucket* buckets;
+        uint64_t bucketMask;
+        uint8_t generation;
+
+        static uint64_t pack(Move move, int score, int depth, Bound bound, uint8_t generation);
+};
+
+#endif
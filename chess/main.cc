@@ -1,9 +1,16 @@
 #include "controller/game.h"
 #include "model/board.h"
 #include "controller/player.h"
+#include "controller/computer.h"
+#include "model/nnue.h"
+#include "model/openingBook.h"
+#include "model/tablebase.h"
 #include "view/textObserver.h"
 #include "view/graphicalObserver.h"
+#include <iostream>
+#include <cstdint>
 #include <limits>
+#include <string>
 
 bool updateGamePlayer(Game& game, Colour colour, std::string player) {
     if (player == "human") {
@@ -16,12 +23,190 @@ bool updateGamePlayer(Game& game, Colour colour, std::string player) {
     }
     return false;
 }
-int main() {
+
+const int MAX_THREADS = 256;
+const int64_t MAX_HASH_MB = 65536;
+
+const char* USAGE =
+    "Usage: ./chess [options]\n"
+    "  --nnue=<file>            evaluate with the NNUE weights in file (level 4)\n"
+    "  --book=<file>            play from a Polyglot opening book (every level)\n"
+    "  --book-depth=<plies>     leave the book after this many plies (default 16)\n"
+    "  --tablebases=<dir>       play KQK, KRK and KPK endings perfectly from tables made by tbgen (level 4)\n"
+    "  --stats=<line|json>      print each search iteration's statistics to stderr (level 4)\n"
+    "  --movetime=<ms>          think this long per move, 0 for no limit (level 4, default 1000)\n"
+    "  --depth=<plies>          search no deeper than this (level 4)\n"
+    "  --nodes=<count>          search at most this many nodes per move (level 4)\n"
+    "  --clock=<ms>             play on a clock with this much time for the game instead (level 4)\n"
+    "  --increment=<ms>         time added to the clock after each move\n"
+    "  --movestogo=<moves>      moves until the clock's next time control, 0 for the whole game\n"
+    "  --threads=<count>        search threads (level 4, default one per core)\n"
+    "  --hash=<MB>              transposition table size (level 4, default 16)\n"
+    "  --no-null-move, --no-lmr, --no-futility\n"
+    "                           switch off a pruning technique (level 4)\n";
+
+//the value of a numeric option, a whole number of at most 18 digits
+bool parseNumber(const std::string& option, const std::string& value, int64_t& number) {
+    if (value.empty() || value.size() > 18 || value.find_first_not_of("0123456789") != std::string::npos) {
+        std::cerr << "Expected a number in " << option << "\n";
+        return false;
+    }
+    number = std::stoll(value);
+    return true;
+}
+
+//reads one "--name=value" command line option into settings, checking that what it names can be loaded
+bool parseOption(const std::string& option, ComputerPlayer::Settings& settings) {
+    std::string::size_type equals = option.find('=');
+    std::string name = option.substr(0, equals);
+    std::string value = equals == std::string::npos ? "" : option.substr(equals + 1);
+
+    if (name == "--nnue") {
+        Nnue::Network network;
+        if (!network.load(value)) {
+            std::cerr << "Could not load a network from " << value << "\n";
+            return false;
+        }
+        std::cout << "Evaluating with " << value << " (" << Nnue::backend() << " kernels)\n";
+        settings.networkPath = value;
+        return true;
+    }
+    if (name == "--book") {
+        OpeningBook book;
+        if (!book.open(value)) {
+            std::cerr << "Could not open the opening book " << value << "\n";
+            return false;
+        }
+        settings.bookPath = value;
+        return true;
+    }
+    if (name == "--tablebases") {
+        Tablebase tablebase;
+        int found = tablebase.open(value);
+        if (found == 0) {
+            std::cerr << "No tablebases found in " << value << "\n";
+            return false;
+        }
+        std::cout << "Using " << found << " of " << Tablebase::NUM_SETS << " tablebases from " << value << "\n";
+        settings.tablebaseDirectory = value;
+        return true;
+    }
+    if (name == "--stats") {
+        if (value != "line" && value != "json") {
+            std::cerr << "Expected line or json in " << option << "\n";
+            return false;
+        }
+        settings.statistics = value == "json" ? ComputerPlayer::Statistics::Json : ComputerPlayer::Statistics::Line;
+        return true;
+    }
+    if (option == "--no-null-move") {
+        settings.searchOptions.nullMove = false;
+        return true;
+    }
+    if (option == "--no-lmr") {
+        settings.searchOptions.lateMoveReductions = false;
+        return true;
+    }
+    if (option == "--no-futility") {
+        settings.searchOptions.futility = false;
+        return true;
+    }
+
+    int64_t number;
+    if (name == "--book-depth") {
+        if (!parseNumber(option, value, number)) {
+            return false;
+        }
+        settings.bookMaxPly = static_cast<int>(number);
+        return true;
+    }
+    if (name == "--movetime") {
+        if (!parseNumber(option, value, number)) {
+            return false;
+        }
+        settings.moveTimeMs = number;
+        return true;
+    }
+    if (name == "--depth") {
+        if (!parseNumber(option, value, number)) {
+            return false;
+        }
+        if (number < 1 || number > Search::MAX_PLY) {
+            std::cerr << "The depth must be 1 to " << Search::MAX_PLY << "\n";
+            return false;
+        }
+        settings.depth = static_cast<int>(number);
+        return true;
+    }
+    if (name == "--nodes") {
+        if (!parseNumber(option, value, number)) {
+            return false;
+        }
+        settings.nodes = static_cast<uint64_t>(number);
+        return true;
+    }
+    if (name == "--clock") {
+        if (!parseNumber(option, value, number)) {
+            return false;
+        }
+        settings.clockMs = number;
+        return true;
+    }
+    if (name == "--increment") {
+        if (!parseNumber(option, value, number)) {
+            return false;
+        }
+        settings.incrementMs = number;
+        return true;
+    }
+    if (name == "--movestogo") {
+        if (!parseNumber(option, value, number)) {
+            return false;
+        }
+        settings.movesToGo = static_cast<int>(number);
+        return true;
+    }
+    if (name == "--threads") {
+        if (!parseNumber(option, value, number)) {
+            return false;
+        }
+        if (number < 1 || number > MAX_THREADS) {
+            std::cerr << "The number of threads must be 1 to " << MAX_THREADS << "\n";
+            return false;
+        }
+        settings.threads = static_cast<int>(number);
+        return true;
+    }
+    if (name == "--hash") {
+        if (!parseNumber(option, value, number)) {
+            return false;
+        }
+        if (number < 1 || number > MAX_HASH_MB) {
+            std::cerr << "The hash size must be 1 to " << MAX_HASH_MB << " MB\n";
+            return false;
+        }
+        settings.hashSizeMB = static_cast<size_t>(number);
+        return true;
+    }
+    std::cerr << "Unknown option " << option << "\n";
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    ComputerPlayer::Settings settings;
+    for (int i = 1; i < argc; i++) {
+        if (!parseOption(argv[i], settings)) {
+            std::cerr << USAGE;
+            return 1;
+        }
+    }
+
     Game game{
         new Board{8}, 
         Player::PlayerType::Human,
         Player::PlayerType::Human
     };
+    game.setComputerSettings(settings);
     Observer* textObs = new TextObserver{&game};
     Observer* graphicalObs = new GraphicalObserver{&game};
 
@@ -0,0 +1,227 @@
+#include "bitboard.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+    //magic bitboard for one square: attacks are looked up by hashing the relevant occupancy
+    struct Magic {
+        Bitboard mask; //relevant occupancy (the rays, excluding the board edge)
+        Bitboard magic;
+        Bitboard* attacks;
+        unsigned shift;
+
+        unsigned index(Bitboard occupied) const {
+#if defined(__BMI2__)
+            return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+            return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+        }
+    };
+
+    Bitboard pawnAttackTable[2][Bitboards::NUM_SQUARES];
+    Bitboard knightAttackTable[Bitboards::NUM_SQUARES];
+    Bitboard kingAttackTable[Bitboards::NUM_SQUARES];
+
+    Bitboard betweenTable[Bitboards::NUM_SQUARES][Bitboards::NUM_SQUARES];
+    Bitboard lineTable[Bitboards::NUM_SQUARES][Bitboards::NUM_SQUARES];
+
+    Magic rookMagics[Bitboards::NUM_SQUARES];
+    Magic bishopMagics[Bitboards::NUM_SQUARES];
+    Bitboard rookTable[0x19000]; //sum over squares of 2^(rook relevant bits)
+    Bitboard bishopTable[0x1480]; //sum over squares of 2^(bishop relevant bits)
+
+    const int rookDirections[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    const int bishopDirections[4][2] = {{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
+
+    //attacks from square in each of the given offsets (only one step, e.g. knight/king)
+    Bitboard stepAttacks(int square, const int offsets[][2], int numOffsets) {
+        Coordinate::Coordinate from = Bitboards::toCoordinate(square);
+        Bitboard attacks = 0;
+        for (int i = 0; i < numOffsets; i++) {
+            Coordinate::Coordinate to{from.row + offsets[i][0], from.col + offsets[i][1]};
+            if (Coordinate::checkBounds(to, 8)) {
+                attacks |= Bitboards::squareBB(Bitboards::toSquare(to));
+            }
+        }
+        return attacks;
+    }
+
+    //walks each ray until the edge of the board or the first occupied square (which is included), used to build the magic tables
+    Bitboard slidingAttacks(int square, Bitboard occupied, const int directions[4][2]) {
+        Coordinate::Coordinate from = Bitboards::toCoordinate(square);
+        Bitboard attacks = 0;
+        for (int i = 0; i < 4; i++) {
+            for (int step = 1;; step++) {
+                Coordinate::Coordinate to{from.row + step * directions[i][0], from.col + step * directions[i][1]};
+                if (!Coordinate::checkBounds(to, 8)) {
+                    break;
+                }
+                Bitboard toBB = Bitboards::squareBB(Bitboards::toSquare(to));
+                attacks |= toBB;
+                if (occupied & toBB) {
+                    break; //blocked
+                }
+            }
+        }
+        return attacks;
+    }
+
+    //xorshift64* generator, seeded per rank so that magic search is deterministic and fast
+    class MagicRng {
+        uint64_t state;
+    public:
+        MagicRng(uint64_t seed): state{seed} {}
+
+        uint64_t next() {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 2685821657736338717ULL;
+        }
+
+        uint64_t sparse() { //magics with few set bits are found much faster
+            return next() & next() & next();
+        }
+    };
+
+    void initMagics(Magic magics[], Bitboard table[], const int directions[4][2]) {
+#if !defined(__BMI2__)
+        const uint64_t seeds[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+        int epoch[4096] = {0}; //which attempt last wrote each table slot, avoids clearing between attempts
+        int attempt = 0;
+        Bitboard occupancy[4096];
+#endif
+        Bitboard reference[4096];
+        Bitboard* next = table;
+
+        for (int square = 0; square < Bitboards::NUM_SQUARES; square++) {
+            Coordinate::Coordinate coord = Bitboards::toCoordinate(square);
+            Bitboard edges = ((Bitboards::RANK_1 | Bitboards::RANK_8) & ~(Bitboards::RANK_1 << (8 * coord.row)))
+                | ((Bitboards::FILE_A | Bitboards::FILE_H) & ~(Bitboards::FILE_A << coord.col));
+
+            Magic& m = magics[square];
+            m.mask = slidingAttacks(square, 0, directions) & ~edges;
+            m.shift = 64 - Bitboards::popCount(m.mask);
+            m.attacks = next;
+
+            //enumerate every subset of the mask (carry-rippler) along with its attacks
+            int size = 0;
+            Bitboard b = 0;
+            do {
+#if !defined(__BMI2__)
+                occupancy[size] = b;
+#endif
+                reference[size] = slidingAttacks(square, b, directions);
+#if defined(__BMI2__)
+                m.attacks[m.index(b)] = reference[size];
+#endif
+                size++;
+                b = (b - m.mask) & m.mask;
+            } while (b);
+            next += size;
+
+#if !defined(__BMI2__)
+            //try random sparse candidates until one maps every subset without a destructive collision
+            MagicRng rng{seeds[coord.row]};
+            for (int i = 0; i < size;) {
+                for (m.magic = 0; Bitboards::popCount((m.magic * m.mask) >> 56) < 6;) {
+                    m.magic = rng.sparse();
+                }
+
+                ++attempt;
+                for (i = 0; i < size; i++) {
+                    unsigned idx = m.index(occupancy[i]);
+                    if (epoch[idx] < attempt) {
+                        epoch[idx] = attempt;
+                        m.attacks[idx] = reference[i];
+                    }
+                    else if (m.attacks[idx] != reference[i]) {
+                        break;
+                    }
+                }
+            }
+#endif
+        }
+    }
+}
+
+void Bitboards::init() {
+    static bool initialized = false;
+    if (initialized) {
+        return;
+    }
+
+    const int knightOffsets[8][2] = {{1, 2}, {1, -2}, {-1, 2}, {-1, -2}, {2, 1}, {2, -1}, {-2, 1}, {-2, -1}};
+    const int kingOffsets[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+    const int whitePawnOffsets[2][2] = {{1, -1}, {1, 1}};
+    const int blackPawnOffsets[2][2] = {{-1, -1}, {-1, 1}};
+
+    for (int square = 0; square < NUM_SQUARES; square++) {
+        knightAttackTable[square] = stepAttacks(square, knightOffsets, 8);
+        kingAttackTable[square] = stepAttacks(square, kingOffsets, 8);
+        pawnAttackTable[0][square] = stepAttacks(square, whitePawnOffsets, 2);
+        pawnAttackTable[1][square] = stepAttacks(square, blackPawnOffsets, 2);
+    }
+
+    initMagics(rookMagics, rookTable, rookDirections);
+    initMagics(bishopMagics, bishopTable, bishopDirections);
+
+    for (int a = 0; a < NUM_SQUARES; a++) {
+        for (int b = 0; b < NUM_SQUARES; b++) {
+            betweenTable[a][b] = 0;
+            lineTable[a][b] = 0;
+            if (a == b) {
+                continue;
+            }
+
+            Bitboard bBB = squareBB(b);
+            if (rookAttacks(a, 0) & bBB) {
+                betweenTable[a][b] = rookAttacks(a, bBB) & rookAttacks(b, squareBB(a));
+                lineTable[a][b] = (rookAttacks(a, 0) & rookAttacks(b, 0)) | squareBB(a) | bBB;
+            }
+            else if (bishopAttacks(a, 0) & bBB) {
+                betweenTable[a][b] = bishopAttacks(a, bBB) & bishopAttacks(b, squareBB(a));
+                lineTable[a][b] = (bishopAttacks(a, 0) & bishopAttacks(b, 0)) | squareBB(a) | bBB;
+            }
+        }
+    }
+
+    initialized = true;
+}
+
+Bitboard Bitboards::between(Square a, Square b) {
+    return betweenTable[a][b];
+}
+
+Bitboard Bitboards::line(Square a, Square b) {
+    return lineTable[a][b];
+}
+
+Bitboard Bitboards::pawnAttacks(Colour colour, Square square) {
+    return pawnAttackTable[colourIndex(colour)][square];
+}
+
+Bitboard Bitboards::knightAttacks(Square square) {
+    return knightAttackTable[square];
+}
+
+Bitboard Bitboards::kingAttacks(Square square) {
+    return kingAttackTable[square];
+}
+
+Bitboard Bitboards::rookAttacks(Square square, Bitboard occupied) {
+    const Magic& m = rookMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+Bitboard Bitboards::bishopAttacks(Square square, Bitboard occupied) {
+    const Magic& m = bishopMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+Bitboard Bitboards::queenAttacks(Square square, Bitboard occupied) {
+    return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+}
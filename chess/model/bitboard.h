@@ -0,0 +1,63 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+#include "../shared/colour.h"
+#include "../shared/coordinate.h"
+
+typedef uint64_t Bitboard;
+typedef uint8_t Square; //row * 8 + col, so a1 is 0 and h8 is 63
+
+namespace Bitboards {
+    const int NUM_SQUARES = 64;
+    const Square NO_SQUARE = 64;
+
+    const Bitboard FILE_A = 0x0101010101010101ULL;
+    const Bitboard FILE_H = FILE_A << 7;
+    const Bitboard RANK_1 = 0xFFULL;
+    const Bitboard RANK_8 = RANK_1 << 56;
+
+    inline Square toSquare(Coordinate::Coordinate coord) {
+        return static_cast<Square>(coord.row * 8 + coord.col);
+    }
+
+    inline Coordinate::Coordinate toCoordinate(Square square) {
+        return Coordinate::Coordinate{square / 8, square % 8};
+    }
+
+    inline Bitboard squareBB(Square square) {
+        return 1ULL << square;
+    }
+
+    inline int popCount(Bitboard b) {
+        return __builtin_popcountll(b);
+    }
+
+    inline Square lsb(Bitboard b) { //b must be non-empty
+        return static_cast<Square>(__builtin_ctzll(b));
+    }
+
+    inline Square popLsb(Bitboard& b) { //removes and returns the lowest set square
+        Square square = lsb(b);
+        b &= b - 1;
+        return square;
+    }
+
+    inline int colourIndex(Colour colour) {
+        return colour == Colour::White ? 0 : 1;
+    }
+
+    void init(); //fills the attack tables (magic bitboards, or PEXT when BMI2 is available), safe to call more than once
+
+    Bitboard between(Square a, Square b); //squares strictly between a and b if they share a rank, file or diagonal, otherwise empty
+    Bitboard line(Square a, Square b); //the whole rank, file or diagonal through a and b, otherwise empty
+
+    Bitboard pawnAttacks(Colour colour, Square square);
+    Bitboard knightAttacks(Square square);
+    Bitboard kingAttacks(Square square);
+    Bitboard rookAttacks(Square square, Bitboard occupied);
+    Bitboard bishopAttacks(Square square, Bitboard occupied);
+    Bitboard queenAttacks(Square square, Bitboard occupied);
+}
+
+#endif
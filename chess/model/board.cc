@@ -8,59 +8,119 @@
 #include "../shared/colour.h"
 #include "../shared/coordinate.h"
 
+#include <cassert>
 #include <cctype>
+#include <sstream>
 #include <string>
-
-Board::Board(int boardDimension): board{new Piece**[boardDimension]}, boardDimension{boardDimension}, boardState{Default}, turnNumber{0} {
-    //this is needed since C++ does not support 2D dynamic array initialization (e.g. new Piece*[boardDimension][boardDimension])
-    for (int i = 0; i < boardDimension; i++) { //initialize 2D array (rows) to nullptr
-        board[i] = new Piece*[boardDimension]{0};
+#include <vector>
+
+namespace {
+    const Square WHITE_KING_HOME = 4;
+    const Square BLACK_KING_HOME = 60;
+
+    //castling rights that survive a move touching square (king or rook home squares revoke rights)
+    int castlingRightsKeptAt(Square square) {
+        switch (square) {
+            case 0: return ~Board::CastlingRight::WhiteQueenSide;
+            case 7: return ~Board::CastlingRight::WhiteKingSide;
+            case WHITE_KING_HOME: return ~(Board::CastlingRight::WhiteKingSide | Board::CastlingRight::WhiteQueenSide);
+            case 56: return ~Board::CastlingRight::BlackQueenSide;
+            case 63: return ~Board::CastlingRight::BlackKingSide;
+            case BLACK_KING_HOME: return ~(Board::CastlingRight::BlackKingSide | Board::CastlingRight::BlackQueenSide);
+            default: return ~0;
+        }
     }
+}
 
+Board::Board(int boardDimension): network{nullptr}, tablebase{nullptr}, boardDimension{boardDimension}, boardState{Default} {
+    Bitboards::init();
+    Zobrist::init();
+    PieceSquare::init();
     resetDefaultChess();
 }
 
-Board::Board(const Board& other): board{new Piece**[other.boardDimension]}, boardDimension{other.boardDimension}, boardState{other.boardState}, turnNumber{0} {
-    //this is needed since C++ does not support 2D dynamic array initialization (e.g. new Piece*[boardDimension][boardDimension])
-    for (int i = 0; i < boardDimension; i++) { //initialize 2D array (rows) to nullptr
-        board[i] = new Piece*[boardDimension]{0};
-    }
-
-    for (int i = 0; i < other.boardDimension; ++i) {
-        for (int j = 0; j < other.boardDimension; ++j) {
-            if (other.board[i][j] != nullptr) {
-                board[i][j] = other.board[i][j]->cloneToBoard(this);
+Board::Board(const Board& other):
+    occupied{other.occupied},
+    castlingRights{other.castlingRights},
+    enPassantSquare{other.enPassantSquare},
+    halfmoveClock{other.halfmoveClock},
+    sideToMove{other.sideToMove},
+    key{other.key},
+    pawnKey{other.pawnKey},
+    middlegameScore{other.middlegameScore},
+    endgameScore{other.endgameScore},
+    phase{other.phase},
+    network{other.network},
+    accumulator(other.accumulator),
+    tablebase{other.tablebase},
+    boardDimension{other.boardDimension},
+    boardState{other.boardState},
+    plyCount{other.plyCount},
+    undoableMoves{other.undoableMoves} {
+        for (int c = 0; c < 2; c++) {
+            colourBitboards[c] = other.colourBitboards[c];
+            material[c] = other.material[c];
+            for (int t = 0; t < 6; t++) {
+                pieceBitboards[c][t] = other.pieceBitboards[c][t];
             }
         }
-    }
-}
-
-Board::~Board() {
-    for (int i = 0; i < boardDimension; i++) {
-        for (int j = 0; j < boardDimension; j++) {
-            delete board[i][j];
+        for (int square = 0; square < Bitboards::NUM_SQUARES; square++) {
+            squares[square] = other.squares[square];
+        }
+        for (int i = 0; i < undoableMoves; i++) { //only the live part of the ring buffer
+            int index = (plyCount - 1 - i) % MAX_HISTORY;
+            moveHistories[index] = other.moveHistories[index];
         }
-        delete[] board[i];
-    }
-    delete[] board;
-    while (!moveHistories.empty()) {
-        History lastMove = moveHistories.top();
-        delete lastMove.oldPiece;
-        delete lastMove.newPiece;
-        delete lastMove.capturedPiece;
-        moveHistories.pop();
     }
-}
 
 Board::BoardState Board::getBoardState() const {
     return boardState;
 }
 
+int Board::pieceCode(Colour colour, Piece::PieceType type) {
+    return Bitboards::colourIndex(colour) * 6 + static_cast<int>(type);
+}
+
+Colour Board::codeColour(int code) {
+    return code < 6 ? Colour::White : Colour::Black;
+}
+
+Piece::PieceType Board::codeType(int code) {
+    return static_cast<Piece::PieceType>(code % 6);
+}
+
+std::unique_ptr<Piece> Board::createPiece(int code, Square square) const {
+    //pieces are lightweight views onto the board, so they may be handed out from const methods
+    Board* b = const_cast<Board*>(this);
+    Coordinate::Coordinate pos = Bitboards::toCoordinate(square);
+    Colour colour = codeColour(code);
+
+    switch (codeType(code)) {
+        case Piece::PieceType::Pawn:
+            return std::unique_ptr<Piece>{new Pawn{pos, colour, b}};
+        case Piece::PieceType::Rook:
+            return std::unique_ptr<Piece>{new Rook{pos, colour, b}};
+        case Piece::PieceType::Knight:
+            return std::unique_ptr<Piece>{new Knight{pos, colour, b}};
+        case Piece::PieceType::Bishop:
+            return std::unique_ptr<Piece>{new Bishop{pos, colour, b}};
+        case Piece::PieceType::Queen:
+            return std::unique_ptr<Piece>{new Queen{pos, colour, b}};
+        case Piece::PieceType::King:
+            return std::unique_ptr<Piece>{new King{pos, colour, b}};
+    }
+    return nullptr;
+}
+
 std::unique_ptr<Piece> Board::getPiece(Coordinate::Coordinate pos) const {
-    if (nullptr == board[pos.row][pos.col]) {
+    if (!Coordinate::checkBounds(pos, boardDimension)) {
         return nullptr;
     }
-    return board[pos.row][pos.col]->clone();
+    Square square = Bitboards::toSquare(pos);
+    if (NO_PIECE == squares[square]) {
+        return nullptr;
+    }
+    return createPiece(squares[square], square);
 }
 
 std::unique_ptr<Piece> Board::getPiece(int x, int y) const {
@@ -71,10 +131,51 @@ std::unique_ptr<Piece> Board::getPiece(std::string pos) const {
     return getPiece(Coordinate::chessToCartesian(pos));
 }
 
+bool Board::isOccupied(Coordinate::Coordinate pos) const {
+    return Coordinate::checkBounds(pos, boardDimension) && NO_PIECE != squares[Bitboards::toSquare(pos)];
+}
+
+Piece::PieceType Board::getPieceTypeAt(Coordinate::Coordinate pos) const {
+    return codeType(squares[Bitboards::toSquare(pos)]);
+}
+
+Piece::PieceType Board::getPieceTypeAt(Square square) const {
+    return codeType(squares[square]);
+}
+
+Colour Board::getColourAt(Coordinate::Coordinate pos) const {
+    return codeColour(squares[Bitboards::toSquare(pos)]);
+}
+
+Coordinate::Coordinate Board::getKingPosition(Colour colour) const {
+    Bitboard king = getPieces(colour, Piece::PieceType::King);
+    if (!king) {
+        return Coordinate::Coordinate{-1, -1};
+    }
+    return Bitboards::toCoordinate(Bitboards::lsb(king));
+}
+
 int Board::getBoardDimension() const {
     return boardDimension;
 }
 
+Bitboard Board::getOccupied() const {
+    return occupied;
+}
+
+Bitboard Board::getPieces(Colour colour) const {
+    return colourBitboards[Bitboards::colourIndex(colour)];
+}
+
+Bitboard Board::getPieces(Colour colour, Piece::PieceType type) const {
+    return pieceBitboards[Bitboards::colourIndex(colour)][static_cast<int>(type)];
+}
+
+bool Board::hasNonPawnMaterial(Colour colour) const {
+    int c = Bitboards::colourIndex(colour);
+    return colourBitboards[c] != (pieceBitboards[c][static_cast<int>(Piece::PieceType::King)] | pieceBitboards[c][static_cast<int>(Piece::PieceType::Pawn)]);
+}
+
 std::unique_ptr<Piece>** Board::cloneBoard() {
     std::unique_ptr<Piece>** clonedBoard = new std::unique_ptr<Piece>*[boardDimension];
     for (int i = 0; i < boardDimension; i++) {
@@ -84,82 +185,234 @@ std::unique_ptr<Piece>** Board::cloneBoard() {
     //populate cloned array
     for (int i = 0; i < boardDimension; i++) {
         for (int j = 0; j < boardDimension; j++) {
-            if (board[i][j] != nullptr) { //piece exists
-                clonedBoard[i][j] = board[i][j]->clone();
-            }
+            clonedBoard[i][j] = getPiece(i, j);
         }
     }
 
     return clonedBoard;
 }
 
-bool Board::canTargetSquare(Coordinate::Coordinate square, Colour colour) const {
-    for (int i = 0; i < boardDimension; i++) {
-        for (int j = 0; j < boardDimension; j++) {
-            if (board[i][j] && board[i][j]->getColour() == colour && board[i][j]->canTargetSquare(square)) {
-                return true;
-            }
+bool Board::hasCastlingRight(CastlingRight right) const {
+    return castlingRights & right;
+}
+
+Coordinate::Coordinate Board::getEnPassantTarget() const {
+    if (Bitboards::NO_SQUARE == enPassantSquare) {
+        return Coordinate::Coordinate{-1, -1};
+    }
+    return Bitboards::toCoordinate(enPassantSquare);
+}
+
+int Board::getHalfmoveClock() const {
+    return halfmoveClock;
+}
+
+int Board::getPlyCount() const {
+    return plyCount;
+}
+
+Colour Board::getSideToMove() const {
+    return sideToMove;
+}
+
+void Board::setSideToMove(Colour colour) {
+    if (colour != sideToMove) {
+        sideToMove = colour;
+        key ^= Zobrist::blackToMove;
+    }
+}
+
+Key Board::getKey() const {
+    return key;
+}
+
+int Board::getMaterial(Colour colour) const {
+    return material[Bitboards::colourIndex(colour)];
+}
+
+int Board::getMiddlegameScore() const {
+    return middlegameScore;
+}
+
+int Board::getEndgameScore() const {
+    return endgameScore;
+}
+
+int Board::getPhase() const {
+    return phase;
+}
+
+void Board::setNetwork(const Nnue::Network* network) {
+    this->network = network;
+    if (!network) {
+        return;
+    }
+
+    network->clear(accumulator);
+    for (int square = 0; square < Bitboards::NUM_SQUARES; square++) {
+        if (NO_PIECE != squares[square]) {
+            network->addPiece(accumulator, squares[square], square);
         }
     }
-    return false;
 }
-bool Board::isKingInCheck(Colour kingColour) const {
-    Coordinate::Coordinate kingPos;
-    for (int i = 0; i < boardDimension; ++i) {
-        for (int j = 0; j < boardDimension; ++j) {
-            Piece* piece = board[i][j];
-            if (piece && piece->getColour() == kingColour && piece->getPieceType() == Piece::PieceType::King) {
-                kingPos = {i, j};
-                break;
-            }
+
+const Nnue::Network* Board::getNetwork() const {
+    return network;
+}
+
+void Board::setTablebase(const Tablebase* tablebase) {
+    this->tablebase = tablebase;
+}
+
+const Tablebase* Board::getTablebase() const {
+    return tablebase;
+}
+
+const Nnue::Accumulator& Board::getAccumulator() const {
+    return accumulator;
+}
+
+Key Board::computeKey() const {
+    Key k = Zobrist::castlingRights[castlingRights];
+    for (int square = 0; square < Bitboards::NUM_SQUARES; square++) {
+        if (NO_PIECE != squares[square]) {
+            k ^= Zobrist::pieceSquare[squares[square]][square];
         }
     }
+    if (Bitboards::NO_SQUARE != enPassantSquare) {
+        k ^= Zobrist::enPassantFile[enPassantSquare % 8];
+    }
+    if (sideToMove == Colour::Black) {
+        k ^= Zobrist::blackToMove;
+    }
+    return k;
+}
+
+Key Board::getPawnKey() const {
+    return pawnKey;
+}
+
+Key Board::computePawnKey() const {
+    Key k = 0;
+    for (int c = 0; c < 2; c++) {
+        Bitboard pawns = pieceBitboards[c][static_cast<int>(Piece::PieceType::Pawn)];
+        while (pawns) {
+            Square square = Bitboards::popLsb(pawns);
+            k ^= Zobrist::pieceSquare[c * 6 + static_cast<int>(Piece::PieceType::Pawn)][square];
+        }
+    }
+    return k;
+}
+
+void Board::verifyKey() const {
+#ifdef ZOBRIST_DEBUG
+    assert(key == computeKey());
+    assert(pawnKey == computePawnKey());
+#endif
+}
+
+void Board::putPiece(int code, Square square) {
+    Bitboard squareBB = Bitboards::squareBB(square);
+    int c = Bitboards::colourIndex(codeColour(code));
+    pieceBitboards[c][static_cast<int>(codeType(code))] |= squareBB;
+    colourBitboards[c] |= squareBB;
+    occupied |= squareBB;
+    squares[square] = code;
+    key ^= Zobrist::pieceSquare[code][square];
+    if (codeType(code) == Piece::PieceType::Pawn) {
+        pawnKey ^= Zobrist::pieceSquare[code][square];
+    }
+
+    material[c] += PieceSquare::material[code];
+    middlegameScore += PieceSquare::middlegame[code][square];
+    endgameScore += PieceSquare::endgame[code][square];
+    phase += PieceSquare::phase[code];
+    if (network) {
+        network->addPiece(accumulator, code, square);
+    }
+}
+
+void Board::clearSquare(Square square) {
+    int code = squares[square];
+    if (NO_PIECE == code) {
+        return;
+    }
+    Bitboard squareBB = Bitboards::squareBB(square);
+    int c = Bitboards::colourIndex(codeColour(code));
+    pieceBitboards[c][static_cast<int>(codeType(code))] &= ~squareBB;
+    colourBitboards[c] &= ~squareBB;
+    occupied &= ~squareBB;
+    squares[square] = NO_PIECE;
+    key ^= Zobrist::pieceSquare[code][square];
+    if (codeType(code) == Piece::PieceType::Pawn) {
+        pawnKey ^= Zobrist::pieceSquare[code][square];
+    }
+
+    material[c] -= PieceSquare::material[code];
+    middlegameScore -= PieceSquare::middlegame[code][square];
+    endgameScore -= PieceSquare::endgame[code][square];
+    phase -= PieceSquare::phase[code];
+    if (network) {
+        network->removePiece(accumulator, code, square);
+    }
+}
+
+Bitboard Board::attackersTo(Square square, Colour colour, Bitboard occupancy) const {
+    Colour opponentColour = (colour == Colour::White) ? Colour::Black : Colour::White;
+    const Bitboard* pieces = pieceBitboards[Bitboards::colourIndex(colour)];
+    Bitboard queens = pieces[static_cast<int>(Piece::PieceType::Queen)];
+
+    //a colour pawn attacks square exactly when an opponent pawn on square would attack the colour pawn
+    return (Bitboards::pawnAttacks(opponentColour, square) & pieces[static_cast<int>(Piece::PieceType::Pawn)])
+        | (Bitboards::knightAttacks(square) & pieces[static_cast<int>(Piece::PieceType::Knight)])
+        | (Bitboards::kingAttacks(square) & pieces[static_cast<int>(Piece::PieceType::King)])
+        | (Bitboards::bishopAttacks(square, occupancy) & (pieces[static_cast<int>(Piece::PieceType::Bishop)] | queens))
+        | (Bitboards::rookAttacks(square, occupancy) & (pieces[static_cast<int>(Piece::PieceType::Rook)] | queens));
+}
+
+bool Board::canTargetSquare(Coordinate::Coordinate square, Colour colour) const {
+    return attackersTo(Bitboards::toSquare(square), colour, occupied) != 0;
+}
+
+bool Board::givesCheck(Move move) {
+    Colour opponentColour = codeColour(squares[move.from()]) == Colour::White ? Colour::Black : Colour::White;
+    makeMove(move);
+    bool check = isKingInCheck(opponentColour);
+    unmakeMove();
+    return check;
+}
+
+bool Board::isInCheck() const {
+    return isKingInCheck(sideToMove);
+}
+
+bool Board::isKingInCheck(Colour kingColour) const {
+    Coordinate::Coordinate kingPos = getKingPosition(kingColour);
+    if (kingPos.row < 0) {
+        return false;
+    }
 
     Colour opponentColour = (kingColour == Colour::White) ? Colour::Black : Colour::White;
     return canTargetSquare(kingPos, opponentColour);
 }
+
 void Board::computeBoardState(Colour turn) {
     //check for check
     bool whiteInCheck = isKingInCheck(Colour::White);
     bool blackInCheck = isKingInCheck(Colour::Black);
 
-    //check if the only pieces on the board are 2 kings and set justMovedTwice to false for all pawns of colour turn
-    bool justKings = true;
-    for (int i = 0; i < boardDimension; i++) {
-        for (int j = 0; j < boardDimension; j++) {
-            if (board[i][j]) {
-                if (board[i][j]->getPieceType() != Piece::PieceType::King) {
-                    justKings = false;
-                }
-                if (board[i][j]->getPieceType() == Piece::PieceType::Pawn && board[i][j]->getColour() == turn) {
-                    Pawn* pawn = dynamic_cast<Pawn*>(board[i][j]);
-                    if (pawn) {
-                        pawn->falsifyJustMovedTwice();
-                    }
-                }
-            }
-        }
-    }
-    if (justKings) {
+    //neither side can mate with bare kings or a single bishop or knight
+    Bitboard kings = pieceBitboards[0][static_cast<int>(Piece::PieceType::King)] | pieceBitboards[1][static_cast<int>(Piece::PieceType::King)];
+    Bitboard minors = pieceBitboards[0][static_cast<int>(Piece::PieceType::Bishop)] | pieceBitboards[1][static_cast<int>(Piece::PieceType::Bishop)] |
+                      pieceBitboards[0][static_cast<int>(Piece::PieceType::Knight)] | pieceBitboards[1][static_cast<int>(Piece::PieceType::Knight)];
+    Bitboard others = occupied & ~kings;
+    if (!others || (Bitboards::popCount(others) == 1 && (others & minors))) {
         boardState = BoardState::Stalemate;
         return;
     }
 
     //does player have any valid moves?
-    bool hasValidMoves = false;
-    for (int i = 0; i < boardDimension; i++) {
-        for (int j = 0; j < boardDimension; j++) {
-            Piece* piece = board[i][j];
-            if (piece != nullptr && piece->getColour() == turn) {
-                std::vector<Coordinate::Coordinate> validMoves = piece->getValidLegalMoves();
-                if (!validMoves.empty()) {
-                    hasValidMoves = true;
-                    break;
-                }
-            }
-        }
-        if (hasValidMoves) break;
-    }
+    bool hasValidMoves = !generateLegalMoves(turn).empty();
 
     if (turn == Colour::White) {
         if (whiteInCheck) {
@@ -190,114 +443,180 @@ void Board::computeBoardState(Colour turn) {
             }
         }
     }
-}
 
-bool Board::takeTurn(Coordinate::Coordinate from, Coordinate::Coordinate to, Colour col, bool simulate, bool incrementTurn) {
-    if (incrementTurn) {
-        ++turnNumber;
-    }
-    
-    // First step: is there a piece at the from coordinate and is it the correct colour?
-    Piece* fromPiece = board[from.row][from.col];
-    if (nullptr == fromPiece || fromPiece->getColour() != col) {
-        return false;
+    //fifty-move rule (checkmate on the hundredth ply still counts)
+    if (halfmoveClock >= 100 && boardState != BoardState::WhiteCheckmated && boardState != BoardState::BlackCheckmated) {
+        boardState = BoardState::Stalemate;
     }
+}
 
-    std::unique_ptr<Piece> clonedFromPiece = fromPiece->clone();
-    std::unique_ptr<Piece> capturedPiece = board[to.row][to.col] ? board[to.row][to.col]->clone() : nullptr;
-    std::unique_ptr<Piece> enPassantPiece = board[from.row][to.col] ? board[from.row][to.col]->clone() : nullptr;
+Square Board::enPassantCaptureSquare(Colour colour, Square to) {
+    //the captured pawn sits directly behind the target square
+    return colour == Colour::White ? to - 8 : to + 8;
+}
 
-    // Second step: can the piece make the move?
-    if (!clonedFromPiece->makeMove(to, simulate)) { //normal move
-        return false;
+void Board::makeMove(Move move) {
+    Square from = move.from();
+    Square to = move.to();
+    int movedPiece = squares[from];
+    Colour colour = codeColour(movedPiece);
+
+    History& history = moveHistories[plyCount % MAX_HISTORY];
+    history = History{
+        key, move, static_cast<int8_t>(squares[to]), static_cast<uint8_t>(castlingRights), enPassantSquare, static_cast<uint16_t>(halfmoveClock)
+    };
+
+    Square capturedSquare = to;
+    if (move.isEnPassant()) {
+        capturedSquare = enPassantCaptureSquare(colour, to);
+        history.capturedPiece = squares[capturedSquare];
     }
 
-    // En passant check
-    bool enPassant = false;
-    if (clonedFromPiece->getPieceType() == Piece::PieceType::Pawn 
-        && to.col != from.col 
-        && board[to.row][to.col] == nullptr) {
-            delete board[from.row][to.col];
-            board[from.row][to.col] = nullptr;
-            enPassant = true;
-    } else {
-        delete board[to.row][to.col];
+    clearSquare(capturedSquare);
+    clearSquare(from);
+    putPiece(move.isPromotion() ? pieceCode(colour, move.promotionType()) : movedPiece, to);
+
+    if (move.isCastle()) { //castling also moves the rook
+        Square rookFrom = move.flags() == Move::KingCastle ? from + 3 : from - 4;
+        Square rookTo = (from + to) / 2;
+        int rook = squares[rookFrom];
+        clearSquare(rookFrom);
+        putPiece(rook, rookTo);
     }
-    board[from.row][from.col] = nullptr;
-    board[to.row][to.col] = clonedFromPiece.release();
 
-    std::unique_ptr<Piece> newPiece = board[to.row][to.col]->clone();
+    halfmoveClock = (codeType(movedPiece) == Piece::PieceType::Pawn || NO_PIECE != history.capturedPiece) ? 0 : halfmoveClock + 1;
 
-    // Third step: add move to history
-    if (enPassant) {
-        moveHistories.push(History{fromPiece, newPiece.release(), enPassantPiece.release(), turnNumber});
-    } else {
-        moveHistories.push(History{fromPiece, newPiece.release(), capturedPiece.release(), turnNumber});
+    if (Bitboards::NO_SQUARE != enPassantSquare) {
+        key ^= Zobrist::enPassantFile[enPassantSquare % 8];
+    }
+    enPassantSquare = move.isDoublePush() ? (from + to) / 2 : Bitboards::NO_SQUARE;
+    if (Bitboards::NO_SQUARE != enPassantSquare) {
+        key ^= Zobrist::enPassantFile[enPassantSquare % 8];
     }
 
-    // Fourth step: has player moved into check?
-    if (isKingInCheck(col)) {
-        undoTurn();
-        return false;
+    key ^= Zobrist::castlingRights[castlingRights];
+    castlingRights &= castlingRightsKeptAt(from) & castlingRightsKeptAt(to);
+    key ^= Zobrist::castlingRights[castlingRights];
+
+    sideToMove = colour == Colour::White ? Colour::Black : Colour::White;
+    key ^= Zobrist::blackToMove;
+
+    ++plyCount;
+    if (undoableMoves < MAX_HISTORY) {
+        ++undoableMoves;
     }
+    verifyKey();
+}
 
-    if (simulate) {
-        undoTurn();
+void Board::makeNullMove() {
+    History& history = moveHistories[plyCount % MAX_HISTORY];
+    history = History{
+        key, Move{}, NO_PIECE, static_cast<uint8_t>(castlingRights), enPassantSquare, static_cast<uint16_t>(halfmoveClock)
+    };
+
+    //the en passant right lapses since the opponent didn't answer the double push
+    if (Bitboards::NO_SQUARE != enPassantSquare) {
+        key ^= Zobrist::enPassantFile[enPassantSquare % 8];
+        enPassantSquare = Bitboards::NO_SQUARE;
     }
+    ++halfmoveClock;
 
-    return true;
+    sideToMove = sideToMove == Colour::White ? Colour::Black : Colour::White;
+    key ^= Zobrist::blackToMove;
+
+    ++plyCount;
+    if (undoableMoves < MAX_HISTORY) {
+        ++undoableMoves;
+    }
+    verifyKey();
 }
 
-void Board::undoTurn() {
- if (moveHistories.empty()) {
+void Board::unmakeMove() {
+    if (undoableMoves == 0) {
         return;
     }
 
-    int lastTurn = moveHistories.top().turnNumber;
-
-    while (!moveHistories.empty()) {
-        if (moveHistories.top().turnNumber != lastTurn)
-            break;
-
-        History lastMove = moveHistories.top();
+    --plyCount;
+    --undoableMoves;
+    const History& lastMove = moveHistories[plyCount % MAX_HISTORY];
+    Move move = lastMove.move;
+    if (move.isNull()) { //only makeNullMove's state changes to revert
+        enPassantSquare = lastMove.enPassantSquare;
+        halfmoveClock = lastMove.halfmoveClock;
+        sideToMove = sideToMove == Colour::White ? Colour::Black : Colour::White;
+        key = lastMove.key;
+        verifyKey();
+        return;
+    }
+    Square from = move.from();
+    Square to = move.to();
+    Colour colour = codeColour(squares[to]);
 
-        Coordinate::Coordinate oldPosition = lastMove.oldPiece->getPosition();
-        Coordinate::Coordinate newPosition = lastMove.newPiece->getPosition();
+    //a promoted piece turns back into the pawn that moved
+    int movedPiece = move.isPromotion() ? pieceCode(colour, Piece::PieceType::Pawn) : squares[to];
+    clearSquare(to);
+    putPiece(movedPiece, from);
 
-        //delete new piece
-        delete board[newPosition.row][newPosition.col];
-        board[newPosition.row][newPosition.col] = nullptr;
-        delete lastMove.newPiece;
+    if (move.isCastle()) {
+        Square rookFrom = move.flags() == Move::KingCastle ? from + 3 : from - 4;
+        Square rookTo = (from + to) / 2;
+        int rook = squares[rookTo];
+        clearSquare(rookTo);
+        putPiece(rook, rookFrom);
+    }
 
-        //restore old piece
-        board[oldPosition.row][oldPosition.col] = lastMove.oldPiece;
+    if (NO_PIECE != lastMove.capturedPiece) {
+        putPiece(lastMove.capturedPiece, move.isEnPassant() ? enPassantCaptureSquare(colour, to) : to);
+    }
 
-        //restore captured piece if there is one
-        if (nullptr != lastMove.capturedPiece) {
-            board[lastMove.capturedPiece->getPosition().row][lastMove.capturedPiece->getPosition().col] = lastMove.capturedPiece;
-        }
+    castlingRights = lastMove.castlingRights;
+    enPassantSquare = lastMove.enPassantSquare;
+    halfmoveClock = lastMove.halfmoveClock;
+    sideToMove = colour;
+    key = lastMove.key; //cheaper than undoing each xor
+    verifyKey();
+}
 
-        moveHistories.pop();
+bool Board::takeTurn(Move move, Colour col) {
+    // The move must be one the legal generator would produce (flags included) for a piece of col
+    Square from = move.from();
+    if (NO_PIECE == squares[from] || codeColour(squares[from]) != col) {
+        return false;
+    }
+    if (!generateLegalMoves(col, Bitboards::squareBB(from)).contains(move)) {
+        return false;
     }
 
-    turnNumber = moveHistories.empty() ? 0 : moveHistories.top().turnNumber + 1;
+    makeMove(move);
+    return true;
 }
 
-bool Board::promote(Coordinate::Coordinate pos, Piece::PieceType pieceType, Colour col) {
-    Piece* piece = board[pos.row][pos.col];
-    if (nullptr == piece || piece->getColour() != col || piece->getPieceType() != Piece::PieceType::Pawn ||
-        pieceType == Piece::PieceType::King || pieceType == Piece::PieceType::Pawn) {
+bool Board::takeTurn(Coordinate::Coordinate from, Coordinate::Coordinate to, Colour col, Piece::PieceType promotion) {
+    if (!Coordinate::checkBounds(from, boardDimension) || !Coordinate::checkBounds(to, boardDimension)) {
         return false;
     }
 
-    if ((col == Colour::White && pos.row == 7) || (col == Colour::Black && pos.row == 0)) {
-        Piece *oldPiece = piece->clone().release();
-        addPiece(col, pieceType, pos);
-        Piece *newPiece = board[pos.row][pos.col]->clone().release();
-        moveHistories.push(History{oldPiece, newPiece, nullptr, turnNumber - 1});
+    // First step: is there a piece at the from coordinate and is it the correct colour?
+    Square fromSquare = Bitboards::toSquare(from);
+    if (NO_PIECE == squares[fromSquare] || codeColour(squares[fromSquare]) != col) {
+        return false;
     }
 
-    return true;
+    // Second step: find the legal move between the squares (promotions come in one move per piece)
+    Square toSquare = Bitboards::toSquare(to);
+    for (const Move& move : generateLegalMoves(col, Bitboards::squareBB(fromSquare))) {
+        if (move.to() == toSquare && (!move.isPromotion() || move.promotionType() == promotion)) {
+            // Third step: make the move and add it to history
+            makeMove(move);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Board::undoTurn() {
+    unmakeMove();
 }
 
 bool Board::addPiece(Colour colour, Piece::PieceType type, Coordinate::Coordinate pos) {
@@ -306,33 +625,11 @@ bool Board::addPiece(Colour colour, Piece::PieceType type, Coordinate::Coordinat
         return false;
     }
 
-    Piece* newPiece = nullptr;
-
-    switch (type) {
-        case Piece::PieceType::Pawn:
-            newPiece = new Pawn{pos, colour, this};
-            break;
-        case Piece::PieceType::Rook:
-            newPiece = new Rook{pos, colour, this};
-            break;
-        case Piece::PieceType::Knight:
-            newPiece = new Knight{pos, colour, this};
-            break;
-        case Piece::PieceType::Bishop:
-            newPiece = new Bishop{pos, colour, this};
-            break;
-        case Piece::PieceType::Queen:
-            newPiece = new Queen{pos, colour, this};
-            break;
-        case Piece::PieceType::King:
-            newPiece = new King{pos, colour, this};
-            break;
-    }
-
-    if (nullptr != board[pos.row][pos.col]) {
-        delete board[pos.row][pos.col]; //delete existing piece
-    }
-    board[pos.row][pos.col] = newPiece;
+    Square square = Bitboards::toSquare(pos);
+    clearSquare(square); //delete existing piece
+    putPiece(pieceCode(colour, type), square);
+    refreshCastlingRights();
+    verifyKey();
     return true;
 }
 
@@ -381,37 +678,45 @@ bool Board::removePiece(Coordinate::Coordinate pos) {
         return false;
     }
 
-    if (nullptr != board[pos.row][pos.col]) {
-        delete board[pos.row][pos.col];
-        board[pos.row][pos.col] = nullptr;
+    Square square = Bitboards::toSquare(pos);
+    if (NO_PIECE != squares[square]) {
+        clearSquare(square);
+        refreshCastlingRights();
+        verifyKey();
         return true;
     }
     return false;
 }
 
-bool Board::verifyBoard() {
-    int numWhiteKing = 0, numBlackKing = 0;
-    for (int i = 0; i < boardDimension; i++) {
-        for (int j = 0; j < boardDimension; j++) {
-            if (board[i][j] != nullptr) {
-                if (board[i][j]->getPieceType() == Piece::PieceType::King) {
-                    //check if more than one white/black king
-                    if (board[i][j]->getColour() == Colour::Black && ++numBlackKing > 1) {
-                        return false;
-                    }
-                    else if (board[i][j]->getColour() == Colour::White && ++numWhiteKing > 1) {
-                        return false;
-                    }
-                }
-                else if ((i == 0 || i == boardDimension - 1) && board[i][j]->getPieceType() == Piece::PieceType::Pawn) {
-                    //no pawn on the first or last ranks
-                    return false;
-                }
-            }
-        }
+void Board::refreshCastlingRights() {
+    //pieces placed during setup count as unmoved, so any king and rook on their home squares may castle
+    key ^= Zobrist::castlingRights[castlingRights];
+    castlingRights = 0;
+    int king = static_cast<int>(Piece::PieceType::King);
+    int rook = static_cast<int>(Piece::PieceType::Rook);
+
+    if (pieceBitboards[0][king] & Bitboards::squareBB(WHITE_KING_HOME)) {
+        if (pieceBitboards[0][rook] & Bitboards::squareBB(7)) castlingRights |= CastlingRight::WhiteKingSide;
+        if (pieceBitboards[0][rook] & Bitboards::squareBB(0)) castlingRights |= CastlingRight::WhiteQueenSide;
+    }
+    if (pieceBitboards[1][king] & Bitboards::squareBB(BLACK_KING_HOME)) {
+        if (pieceBitboards[1][rook] & Bitboards::squareBB(63)) castlingRights |= CastlingRight::BlackKingSide;
+        if (pieceBitboards[1][rook] & Bitboards::squareBB(56)) castlingRights |= CastlingRight::BlackQueenSide;
     }
+    key ^= Zobrist::castlingRights[castlingRights];
+}
+
+bool Board::verifyBoard() {
+    int king = static_cast<int>(Piece::PieceType::King);
+    int pawn = static_cast<int>(Piece::PieceType::Pawn);
+
     //exactly one white and one black king
-    if (numWhiteKing != 1 || numBlackKing != 1) {
+    if (Bitboards::popCount(pieceBitboards[0][king]) != 1 || Bitboards::popCount(pieceBitboards[1][king]) != 1) {
+        return false;
+    }
+
+    //no pawn on the first or last ranks
+    if ((pieceBitboards[0][pawn] | pieceBitboards[1][pawn]) & (Bitboards::RANK_1 | Bitboards::RANK_8)) {
         return false;
     }
 
@@ -452,14 +757,86 @@ void Board::resetDefaultChess() {
     }
 }
 
+bool Board::loadFen(const std::string& fen) {
+    if (boardDimension != 8) {
+        return false;
+    }
+
+    std::istringstream fields{fen};
+    std::string placement, side = "w", castling = "-", enPassant = "-";
+    int halfmoves = 0;
+    fields >> placement >> side >> castling >> enPassant >> halfmoves;
+
+    reset();
+
+    //ranks are listed from the 8th down to the 1st
+    int row = 7, col = 0;
+    for (char c : placement) {
+        if (c == '/') {
+            --row;
+            col = 0;
+        }
+        else if (c >= '1' && c <= '8') {
+            col += c - '0';
+        }
+        else if (row < 0 || col > 7 || !addPiece(std::string(1, c), Coordinate::Coordinate{row, col++})) {
+            reset();
+            return false;
+        }
+    }
+
+    setSideToMove(side == "b" ? Colour::Black : Colour::White);
+
+    //addPiece grants every right whose king and rook are home, keep only those the FEN lists
+    int listed = 0;
+    for (char c : castling) {
+        switch (c) {
+            case 'K': listed |= CastlingRight::WhiteKingSide; break;
+            case 'Q': listed |= CastlingRight::WhiteQueenSide; break;
+            case 'k': listed |= CastlingRight::BlackKingSide; break;
+            case 'q': listed |= CastlingRight::BlackQueenSide; break;
+            default: break;
+        }
+    }
+    key ^= Zobrist::castlingRights[castlingRights];
+    castlingRights &= listed;
+    key ^= Zobrist::castlingRights[castlingRights];
+
+    if (Coordinate::checkValidChess(enPassant)) {
+        enPassantSquare = Bitboards::toSquare(Coordinate::chessToCartesian(enPassant));
+        key ^= Zobrist::enPassantFile[enPassantSquare % 8];
+    }
+    halfmoveClock = halfmoves;
+
+    verifyKey();
+    return true;
+}
+
 void Board::reset() {
     boardState = BoardState::Default;
-    for (int i = 0; i < boardDimension; i++) {
-        for (int j = 0; j < boardDimension; j++) {
-            if (board[i][j] != nullptr) {
-                delete board[i][j];
-                board[i][j] = nullptr;
-            }
+    for (int c = 0; c < 2; c++) {
+        colourBitboards[c] = 0;
+        material[c] = 0;
+        for (int t = 0; t < 6; t++) {
+            pieceBitboards[c][t] = 0;
         }
     }
+    occupied = 0;
+    for (int square = 0; square < Bitboards::NUM_SQUARES; square++) {
+        squares[square] = NO_PIECE;
+    }
+    castlingRights = 0;
+    enPassantSquare = Bitboards::NO_SQUARE;
+    halfmoveClock = 0;
+    sideToMove = Colour::White;
+    key = computeKey();
+    pawnKey = 0;
+    middlegameScore = 0;
+    endgameScore = 0;
+    phase = 0;
+    if (network) {
+        network->clear(accumulator);
+    }
+    plyCount = 0;
+    undoableMoves = 0;
 }
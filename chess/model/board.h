@@ -2,10 +2,17 @@
 #define BOARD_H
 
 #include "piece.h"
+#include "bitboard.h"
+#include "move.h"
+#include "moveList.h"
+#include "nnue.h"
+#include "pieceSquare.h"
+#include "tablebase.h"
+#include "zobrist.h"
 #include "../shared/coordinate.h"
 #include "../shared/colour.h"
+#include <cstdint>
 #include <memory>
-#include <stack>
 #include <string>
 #include <utility>
 
@@ -20,44 +27,133 @@ class Board {
             Stalemate
         };
 
+        enum CastlingRight {
+            WhiteKingSide = 1,
+            WhiteQueenSide = 2,
+            BlackKingSide = 4,
+            BlackQueenSide = 8
+        };
+
         Board(int boardDimension); //CTOR
         Board(const Board& other); //COPY CTOR
-        ~Board(); //DTOR
+        ~Board() = default; //DTOR
 
         void computeBoardState(Colour turn);
         BoardState getBoardState() const;
         std::unique_ptr<Piece> getPiece(Coordinate::Coordinate pos) const;
         std::unique_ptr<Piece> getPiece(int i, int j) const;
         std::unique_ptr<Piece> getPiece(std::string pos) const;
+        bool isOccupied(Coordinate::Coordinate pos) const; //read-only queries below never allocate
+        Piece::PieceType getPieceTypeAt(Coordinate::Coordinate pos) const; //pos must be occupied
+        Piece::PieceType getPieceTypeAt(Square square) const; //square must be occupied
+        Colour getColourAt(Coordinate::Coordinate pos) const; //pos must be occupied
+        Coordinate::Coordinate getKingPosition(Colour colour) const; //{-1, -1} if there is no king
         int getBoardDimension() const;
+        Bitboard getOccupied() const;
+        Bitboard getPieces(Colour colour) const;
+        Bitboard getPieces(Colour colour, Piece::PieceType type) const;
         std::unique_ptr<Piece>** cloneBoard();
-        bool takeTurn(Coordinate::Coordinate from, Coordinate::Coordinate to, Colour col, bool simulate = false, bool incrementTurn = true);
+        bool hasCastlingRight(CastlingRight right) const;
+        Coordinate::Coordinate getEnPassantTarget() const; //square a pawn may capture en passant on, {-1, -1} if none
+        int getHalfmoveClock() const; //plies since the last capture or pawn move
+        int getPlyCount() const; //moves made since the last reset (or FEN load)
+        Colour getSideToMove() const;
+        void setSideToMove(Colour colour); //called by Game during setup, moves flip it afterwards
+        Key getKey() const; //Zobrist key of pieces, side to move, castling rights and en passant file
+        Key computeKey() const; //same key computed from scratch, the incremental one is checked against it with -DZOBRIST_DEBUG
+        Key getPawnKey() const; //Zobrist key of the pawns alone, 0 without pawns
+        Key computePawnKey() const;
+        int getMaterial(Colour colour) const; //centipawns of colour's pieces, the king not counted
+        int getMiddlegameScore() const; //sum of the PieceSquare middlegame terms (material included), white's point of view
+        int getEndgameScore() const; //as getMiddlegameScore, for the endgame terms
+        int getPhase() const; //PieceSquare::MAX_PHASE in the opening (more after promotions), 0 with only kings and pawns
+        void setNetwork(const Nnue::Network* network); //keeps an accumulator for network from now on (nullptr to stop), network must outlive the board
+        const Nnue::Network* getNetwork() const;
+        const Nnue::Accumulator& getAccumulator() const; //only meaningful while a network is set
+        void setTablebase(const Tablebase* tablebase); //probed by the search (nullptr to stop), must outlive the board
+        const Tablebase* getTablebase() const;
+        bool takeTurn(Move move, Colour col); //plays move if it is legal for col
+        bool takeTurn(Coordinate::Coordinate from, Coordinate::Coordinate to, Colour col,
+            Piece::PieceType promotion = Piece::PieceType::Queen); //promotion is ignored unless a pawn reaches the last rank
         void undoTurn();
+        void makeMove(Move move); //no legality checks, for callers that generated the move
+        void unmakeMove(); //reverts the last makeMove, makeNullMove (or takeTurn), no-op once the history is exhausted
+        void makeNullMove(); //passes the turn without moving, for the search's null-move pruning (never while in check)
+        bool hasNonPawnMaterial(Colour colour) const; //any piece besides the king and pawns
         bool canTargetSquare(Coordinate::Coordinate square, Colour colour) const; //can any of colour's piece target the square?
-        bool promote(Coordinate::Coordinate pos, Piece::PieceType pieceType, Colour col);
+        MoveList generateLegalMoves(Colour colour, Bitboard fromMask = ~0ULL) const; //only moves of pieces on fromMask
+        MoveList generateCaptures(Colour colour) const; //legal captures (en passant included) and promotions only
+        bool givesCheck(Move move); //would the (legal) move attack the enemy king
+        bool isInCheck() const; //is the side to move's king attacked
         bool addPiece(std::string pieceCode, Coordinate::Coordinate pos);
         bool addPiece(Colour colour, Piece::PieceType type, Coordinate::Coordinate pos);
         bool removePiece(Coordinate::Coordinate pos);
         bool verifyBoard(); //called by Game during setup
         void resetDefaultChess();
+        bool loadFen(const std::string& fen); //8x8 only, missing fields default to white to move with no castling or en passant
         void reset(); //called by Game during setup
 
     protected:
 
     private:
-        struct History {
-            Piece* oldPiece;
-            Piece* newPiece;
-            Piece* capturedPiece;
-            int turnNumber;
+        static const int NO_PIECE = -1;
+        static const int MAX_HISTORY = 1024; //undo records kept, older moves are forgotten
+
+        struct History { //undo record, one per move, a null move for makeNullMove (the move's flags say how to revert castling, en passant and promotion)
+            Key key; //state before the move
+            Move move;
+            int8_t capturedPiece; //NO_PIECE if nothing was captured
+            uint8_t castlingRights; //state before the move
+            Square enPassantSquare; //state before the move
+            uint16_t halfmoveClock; //state before the move
         };
 
-        Piece*** board;
+        //position (8x8 only): one bitboard per colour and piece type, plus occupancy masks
+        Bitboard pieceBitboards[2][6]; //indexed by [Bitboards::colourIndex][PieceType]
+        Bitboard colourBitboards[2];
+        Bitboard occupied;
+        int squares[Bitboards::NUM_SQUARES]; //piece code on each square for O(1) lookups
+        int castlingRights;
+        Square enPassantSquare;
+        int halfmoveClock;
+        Colour sideToMove;
+        Key key; //kept up to date by putPiece, clearSquare and the state changes in makeMove
+        Key pawnKey; //kept up to date by putPiece and clearSquare
+
+        //evaluation terms, kept up to date by putPiece and clearSquare
+        int material[2]; //indexed by Bitboards::colourIndex
+        int middlegameScore;
+        int endgameScore;
+        int phase;
+        const Nnue::Network* network; //not owned, copies of the board share it
+        Nnue::Accumulator accumulator;
+        const Tablebase* tablebase; //not owned, copies of the board share it
+
         int boardDimension;
         BoardState boardState;
-        std::stack<History> moveHistories;
-        int turnNumber;
+        History moveHistories[MAX_HISTORY]; //ring buffer indexed by plyCount
+        int plyCount; //moves made since the last reset
+        int undoableMoves; //records still available to unmakeMove
+
+        static int pieceCode(Colour colour, Piece::PieceType type);
+        static Colour codeColour(int code);
+        static Piece::PieceType codeType(int code);
+
+        std::unique_ptr<Piece> createPiece(int code, Square square) const;
+        void putPiece(int code, Square square);
+        void clearSquare(Square square);
+        static Square enPassantCaptureSquare(Colour colour, Square to);
+        void refreshCastlingRights();
+        void verifyKey() const; //asserts key == computeKey() (and the same for the pawn key) when built with -DZOBRIST_DEBUG, otherwise does nothing
         bool isKingInCheck(Colour kingColour) const;
+        Bitboard attackersTo(Square square, Colour colour, Bitboard occupancy) const; //colour's pieces attacking square given occupancy
+
+        //movegen.cc
+        MoveList generateMoves(Colour colour, Bitboard fromMask, bool capturesOnly) const;
+        void addMoves(MoveList& moves, Square from, Bitboard targets) const; //flags each move as a capture or quiet move
+        void addPawnMoves(MoveList& moves, Square from, Bitboard targets) const; //as addMoves, but moves to the last rank become four promotions
+        void generatePawnMoves(MoveList& moves, Colour colour, Bitboard fromMask, Bitboard pinned, Bitboard checkMask, Bitboard checkers, bool capturesOnly) const;
+        void generateKingMoves(MoveList& moves, Colour colour, bool inCheck, bool capturesOnly) const;
 };
 
 #endif
@@ -0,0 +1,54 @@
+#include "mappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(): bytes{nullptr}, length{0} {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); //a mapping keeps its own reference to the file
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    bytes = static_cast<const unsigned char*>(mapped);
+    length = info.st_size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) {
+        munmap(const_cast<unsigned char*>(bytes), length);
+        bytes = nullptr;
+        length = 0;
+    }
+}
+
+bool MappedFile::isOpen() const {
+    return bytes != nullptr;
+}
+
+const unsigned char* MappedFile::data() const {
+    return bytes;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
@@ -0,0 +1,28 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// A whole file mapped read only into memory, for the opening book and the tablebases. Pages are only read
+// from disk when first touched and are shared with every other process mapping the same file.
+class MappedFile {
+    public:
+        MappedFile(); //CTOR, nothing mapped
+        ~MappedFile(); //DTOR, unmaps the file
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+
+        bool open(const std::string& path); //false, leaving nothing mapped, if the file is missing, empty or can't be mapped
+        void close();
+        bool isOpen() const;
+
+        const unsigned char* data() const; //nullptr when closed
+        size_t size() const; //bytes, 0 when closed
+
+    private:
+        const unsigned char* bytes;
+        size_t length;
+};
+
+#endif
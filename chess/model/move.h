@@ -0,0 +1,83 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <cstdint>
+#include <string>
+#include "bitboard.h"
+#include "piece.h"
+
+// A move packed into 16 bits: from square (bits 0-5), to square (bits 6-11) and flags (bits 12-15).
+// Flags follow the usual from-to-flags layout: bit 2 marks captures, bit 3 marks promotions
+// and the low two bits then give the promoted piece.
+class Move {
+    public:
+        enum Flag {
+            Quiet = 0,
+            DoublePush = 1,
+            KingCastle = 2,
+            QueenCastle = 3,
+            Capture = 4,
+            EnPassant = 5,
+            Promotion = 8 //+ 0 knight, 1 bishop, 2 rook, 3 queen, + Capture for capturing promotions
+        };
+
+        Move() = default; //uninitialised like a built-in, use Move{} for the null move
+        Move(Square from, Square to, int flags = Quiet):
+            data{static_cast<uint16_t>(from | (to << 6) | (flags << 12))} {}
+
+        Square from() const { return data & 0x3F; }
+        Square to() const { return (data >> 6) & 0x3F; }
+        int flags() const { return data >> 12; }
+
+        bool isNull() const { return data == 0; } //a1 to a1 is never a real move
+        bool isCapture() const { return flags() & Capture; } //en passant included
+        bool isPromotion() const { return flags() & Promotion; }
+        bool isEnPassant() const { return flags() == EnPassant; }
+        bool isDoublePush() const { return flags() == DoublePush; }
+        bool isCastle() const { return flags() == KingCastle || flags() == QueenCastle; }
+        Piece::PieceType promotionType() const; //only meaningful if isPromotion()
+
+        static int promotionFlag(Piece::PieceType type); //Promotion plus the piece bits, type must be N, B, R or Q
+
+        uint16_t raw() const { return data; }
+        static Move fromRaw(uint16_t raw) { Move move; move.data = raw; return move; }
+        std::string toString() const; //coordinate notation, e.g. e2e4 or e7e8q
+
+        bool operator==(const Move& other) const { return data == other.data; }
+        bool operator!=(const Move& other) const { return data != other.data; }
+
+    private:
+        uint16_t data;
+};
+
+inline Piece::PieceType Move::promotionType() const {
+    switch (flags() & 3) {
+        case 0: return Piece::PieceType::Knight;
+        case 1: return Piece::PieceType::Bishop;
+        case 2: return Piece::PieceType::Rook;
+        default: return Piece::PieceType::Queen;
+    }
+}
+
+inline int Move::promotionFlag(Piece::PieceType type) {
+    switch (type) {
+        case Piece::PieceType::Knight: return Promotion;
+        case Piece::PieceType::Bishop: return Promotion | 1;
+        case Piece::PieceType::Rook: return Promotion | 2;
+        default: return Promotion | 3;
+    }
+}
+
+inline std::string Move::toString() const {
+    const char promotionChars[4] = {'n', 'b', 'r', 'q'};
+    std::string s = Coordinate::cartesianToChess(Bitboards::toCoordinate(from()))
+        + Coordinate::cartesianToChess(Bitboards::toCoordinate(to()));
+    if (isPromotion()) {
+        s += promotionChars[flags() & 3];
+    }
+    return s;
+}
+
+static_assert(sizeof(Move) == 2, "Move must stay packed into 16 bits");
+
+#endif
@@ -0,0 +1,55 @@
+#include "moveList.h"
+
+MoveList::MoveList(): count{0} {}
+
+bool MoveList::contains(const Move& move) const {
+    for (int i = 0; i < count; i++) {
+        if (moves[i] == move) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MoveList::remove(int i) {
+    --count;
+    moves[i] = moves[count];
+    scores[i] = scores[count];
+}
+
+void MoveList::swap(int i, int j) {
+    Move move = moves[i];
+    moves[i] = moves[j];
+    moves[j] = move;
+
+    int score = scores[i];
+    scores[i] = scores[j];
+    scores[j] = score;
+}
+
+void MoveList::sort() {
+    //insertion sort: lists are short and often nearly sorted already
+    for (int i = 1; i < count; i++) {
+        Move move = moves[i];
+        int score = scores[i];
+        int j = i - 1;
+        while (j >= 0 && scores[j] < score) {
+            moves[j + 1] = moves[j];
+            scores[j + 1] = scores[j];
+            --j;
+        }
+        moves[j + 1] = move;
+        scores[j + 1] = score;
+    }
+}
+
+const Move& MoveList::pickNext(int i) {
+    int best = i;
+    for (int j = i + 1; j < count; j++) {
+        if (scores[j] > scores[best]) {
+            best = j;
+        }
+    }
+    swap(i, best);
+    return moves[i];
+}
@@ -0,0 +1,47 @@
+#ifndef MOVELIST_H
+#define MOVELIST_H
+
+#include "move.h"
+
+// Fixed-capacity, stack-allocated list of moves with a score per move for ordering.
+// No chess position has more than 218 legal moves, so generation never overflows.
+class MoveList {
+    public:
+        static const int CAPACITY = 256;
+
+        MoveList(); //CTOR
+
+        void push(const Move& move, int score = 0) {
+            moves[count] = move;
+            scores[count] = score;
+            ++count;
+        }
+
+        int size() const { return count; }
+        bool empty() const { return count == 0; }
+        void clear() { count = 0; }
+
+        Move& operator[](int i) { return moves[i]; }
+        const Move& operator[](int i) const { return moves[i]; }
+        int& scoreAt(int i) { return scores[i]; }
+        int scoreAt(int i) const { return scores[i]; }
+
+        Move* begin() { return moves; }
+        Move* end() { return moves + count; }
+        const Move* begin() const { return moves; }
+        const Move* end() const { return moves + count; }
+
+        bool contains(const Move& move) const;
+        void remove(int i); //swaps the last move into i, does not preserve order
+        void sort(); //highest score first, equal scores keep their relative order
+        const Move& pickNext(int i); //moves the best scored move in [i, size) to i and returns it
+
+    private:
+        Move moves[CAPACITY];
+        int scores[CAPACITY];
+        int count;
+
+        void swap(int i, int j);
+};
+
+#endif
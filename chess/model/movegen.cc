@@ -0,0 +1,194 @@
+#include "board.h"
+
+// Legal move generation: pins and check evasion masks are computed once per position,
+// so every emitted move is legal without making it and testing for check.
+
+MoveList Board::generateLegalMoves(Colour colour, Bitboard fromMask) const {
+    return generateMoves(colour, fromMask, false);
+}
+
+MoveList Board::generateCaptures(Colour colour) const {
+    return generateMoves(colour, ~0ULL, true);
+}
+
+MoveList Board::generateMoves(Colour colour, Bitboard fromMask, bool capturesOnly) const {
+    MoveList moves;
+    Colour opponentColour = (colour == Colour::White) ? Colour::Black : Colour::White;
+    Bitboard us = getPieces(colour);
+    Bitboard king = getPieces(colour, Piece::PieceType::King);
+
+    Bitboard checkers = 0;
+    Bitboard checkMask = ~0ULL; //squares a non-king move must land on (capture the checker or block)
+    Bitboard pinned = 0;
+
+    if (king) { //setup may leave a side without its king, in which case nothing is pinned
+        Square kingSquare = Bitboards::lsb(king);
+        checkers = attackersTo(kingSquare, opponentColour, occupied);
+
+        if (king & fromMask) {
+            generateKingMoves(moves, colour, checkers != 0, capturesOnly);
+        }
+
+        if (Bitboards::popCount(checkers) > 1) { //double check: only the king may move
+            return moves;
+        }
+        if (checkers) {
+            checkMask = Bitboards::between(kingSquare, Bitboards::lsb(checkers)) | checkers;
+        }
+
+        //a piece is pinned if it is our only piece between the king and an enemy slider
+        Bitboard queens = getPieces(opponentColour, Piece::PieceType::Queen);
+        Bitboard snipers = (Bitboards::rookAttacks(kingSquare, 0) & (getPieces(opponentColour, Piece::PieceType::Rook) | queens))
+            | (Bitboards::bishopAttacks(kingSquare, 0) & (getPieces(opponentColour, Piece::PieceType::Bishop) | queens));
+        while (snipers) {
+            Bitboard blockers = Bitboards::between(kingSquare, Bitboards::popLsb(snipers)) & occupied;
+            if (Bitboards::popCount(blockers) == 1 && (blockers & us)) {
+                pinned |= blockers;
+            }
+        }
+    }
+
+    generatePawnMoves(moves, colour, fromMask, pinned, checkMask, checkers, capturesOnly);
+
+    Bitboard destinations = capturesOnly ? getPieces(opponentColour) : ~us;
+
+    Bitboard pieces = us & fromMask & ~getPieces(colour, Piece::PieceType::Pawn) & ~king;
+    while (pieces) {
+        Square from = Bitboards::popLsb(pieces);
+        Bitboard targets = 0;
+        switch (codeType(squares[from])) {
+            case Piece::PieceType::Knight:
+                targets = Bitboards::knightAttacks(from);
+                break;
+            case Piece::PieceType::Bishop:
+                targets = Bitboards::bishopAttacks(from, occupied);
+                break;
+            case Piece::PieceType::Rook:
+                targets = Bitboards::rookAttacks(from, occupied);
+                break;
+            case Piece::PieceType::Queen:
+                targets = Bitboards::queenAttacks(from, occupied);
+                break;
+            default:
+                break;
+        }
+
+        targets &= destinations & checkMask;
+        if (pinned & Bitboards::squareBB(from)) { //pinned pieces may only slide along the pin
+            targets &= Bitboards::line(Bitboards::lsb(king), from);
+        }
+        addMoves(moves, from, targets);
+    }
+
+    return moves;
+}
+
+void Board::addMoves(MoveList& moves, Square from, Bitboard targets) const {
+    Bitboard captures = targets & occupied;
+    targets &= ~occupied;
+    while (captures) {
+        moves.push(Move{from, Bitboards::popLsb(captures), Move::Capture});
+    }
+    while (targets) {
+        moves.push(Move{from, Bitboards::popLsb(targets)});
+    }
+}
+
+void Board::addPawnMoves(MoveList& moves, Square from, Bitboard targets) const {
+    const Piece::PieceType promotions[4] = {
+        Piece::PieceType::Queen, Piece::PieceType::Rook, Piece::PieceType::Bishop, Piece::PieceType::Knight
+    };
+
+    Bitboard promoting = targets & (Bitboards::RANK_1 | Bitboards::RANK_8);
+    addMoves(moves, from, targets & ~promoting);
+    while (promoting) {
+        Square to = Bitboards::popLsb(promoting);
+        int capture = (occupied & Bitboards::squareBB(to)) ? Move::Capture : Move::Quiet;
+        for (Piece::PieceType type : promotions) {
+            moves.push(Move{from, to, Move::promotionFlag(type) | capture});
+        }
+    }
+}
+
+void Board::generatePawnMoves(MoveList& moves, Colour colour, Bitboard fromMask, Bitboard pinned, Bitboard checkMask, Bitboard checkers, bool capturesOnly) const {
+    Colour opponentColour = (colour == Colour::White) ? Colour::Black : Colour::White;
+    Bitboard king = getPieces(colour, Piece::PieceType::King);
+    Bitboard enemies = getPieces(opponentColour);
+    Bitboard startRank = colour == Colour::White ? Bitboards::RANK_1 << 8 : Bitboards::RANK_1 << 48;
+    Bitboard pushMask = capturesOnly ? Bitboards::RANK_1 | Bitboards::RANK_8 : ~0ULL; //only pushes that promote count as captures
+    int up = colour == Colour::White ? 8 : -8;
+
+    Bitboard pawns = getPieces(colour, Piece::PieceType::Pawn) & fromMask;
+    while (pawns) {
+        Square from = Bitboards::popLsb(pawns);
+        Bitboard allowed = checkMask;
+        if (pinned & Bitboards::squareBB(from)) {
+            allowed &= Bitboards::line(Bitboards::lsb(king), from);
+        }
+
+        Bitboard targets = 0;
+        Square oneStep = from + up;
+        if (!(occupied & Bitboards::squareBB(oneStep))) {
+            targets |= Bitboards::squareBB(oneStep) & pushMask;
+            Square twoSteps = oneStep + up;
+            if (!capturesOnly && (startRank & Bitboards::squareBB(from)) && !(occupied & Bitboards::squareBB(twoSteps))
+                && (allowed & Bitboards::squareBB(twoSteps))) {
+                moves.push(Move{from, twoSteps, Move::DoublePush});
+            }
+        }
+        targets |= Bitboards::pawnAttacks(colour, from) & enemies;
+        addPawnMoves(moves, from, targets & allowed);
+
+        //en passant removes two pawns from one rank, so test the resulting position for a discovered slider attack
+        if (Bitboards::NO_SQUARE != enPassantSquare && (Bitboards::pawnAttacks(colour, from) & Bitboards::squareBB(enPassantSquare))) {
+            Bitboard capturedBB = Bitboards::squareBB(enPassantSquare - up);
+            bool evades = !checkers || (checkers & capturedBB) || (checkMask & Bitboards::squareBB(enPassantSquare));
+            bool exposesKing = false;
+            if (king) {
+                Square kingSquare = Bitboards::lsb(king);
+                Bitboard after = (occupied ^ Bitboards::squareBB(from) ^ capturedBB) | Bitboards::squareBB(enPassantSquare);
+                Bitboard queens = getPieces(opponentColour, Piece::PieceType::Queen);
+                exposesKing = (Bitboards::rookAttacks(kingSquare, after) & (getPieces(opponentColour, Piece::PieceType::Rook) | queens))
+                    || (Bitboards::bishopAttacks(kingSquare, after) & (getPieces(opponentColour, Piece::PieceType::Bishop) | queens));
+            }
+            if (evades && !exposesKing) {
+                moves.push(Move{from, enPassantSquare, Move::EnPassant});
+            }
+        }
+    }
+}
+
+void Board::generateKingMoves(MoveList& moves, Colour colour, bool inCheck, bool capturesOnly) const {
+    Colour opponentColour = (colour == Colour::White) ? Colour::Black : Colour::White;
+    Square from = Bitboards::lsb(getPieces(colour, Piece::PieceType::King));
+
+    //the king must not hide behind itself from a slider, so it is removed from the occupancy
+    Bitboard occupancyWithoutKing = occupied ^ Bitboards::squareBB(from);
+    Bitboard targets = Bitboards::kingAttacks(from) & (capturesOnly ? getPieces(opponentColour) : ~getPieces(colour));
+    Bitboard safeTargets = 0;
+    while (targets) {
+        Square to = Bitboards::popLsb(targets);
+        if (!attackersTo(to, opponentColour, occupancyWithoutKing)) {
+            safeTargets |= Bitboards::squareBB(to);
+        }
+    }
+
+    addMoves(moves, from, safeTargets);
+
+    //castling: rights imply king and rook are on their home squares, the king may not leave, pass or land in check
+    if (!inCheck && !capturesOnly) {
+        CastlingRight kingSide = colour == Colour::White ? CastlingRight::WhiteKingSide : CastlingRight::BlackKingSide;
+        CastlingRight queenSide = colour == Colour::White ? CastlingRight::WhiteQueenSide : CastlingRight::BlackQueenSide;
+
+        if (hasCastlingRight(kingSide)
+            && !(occupied & (Bitboards::squareBB(from + 1) | Bitboards::squareBB(from + 2)))
+            && !attackersTo(from + 1, opponentColour, occupied) && !attackersTo(from + 2, opponentColour, occupied)) {
+            moves.push(Move{from, static_cast<Square>(from + 2), Move::KingCastle});
+        }
+        if (hasCastlingRight(queenSide)
+            && !(occupied & (Bitboards::squareBB(from - 1) | Bitboards::squareBB(from - 2) | Bitboards::squareBB(from - 3)))
+            && !attackersTo(from - 1, opponentColour, occupied) && !attackersTo(from - 2, opponentColour, occupied)) {
+            moves.push(Move{from, static_cast<Square>(from - 2), Move::QueenCastle});
+        }
+    }
+}
@@ -0,0 +1,183 @@
+#include "nnue.h"
+#include <cstring>
+#include <fstream>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace {
+    const char MAGIC[8] = {'C', 'H', 'N', 'N', 'U', 'E', '0', '1'};
+    const int CLIP = 255; //first layer activations are clamped to [0, CLIP]
+    const int OUTPUT_QUANTIZATION = 64;
+    const int OUTPUT_SCALE = 400; //network output units per centipawn, times CLIP * OUTPUT_QUANTIZATION
+
+#if defined(__AVX2__)
+    const int LANES = 16;
+
+    void addColumn(int16_t* accumulator, const int16_t* column) {
+        for (int i = 0; i < Nnue::HIDDEN; i += LANES) {
+            __m256i sums = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + i));
+            __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulator + i), _mm256_add_epi16(sums, weights));
+        }
+    }
+
+    void subtractColumn(int16_t* accumulator, const int16_t* column) {
+        for (int i = 0; i < Nnue::HIDDEN; i += LANES) {
+            __m256i sums = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + i));
+            __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulator + i), _mm256_sub_epi16(sums, weights));
+        }
+    }
+
+    int32_t clippedDot(const int16_t* accumulator, const int16_t* weights) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i clip = _mm256_set1_epi16(CLIP);
+        __m256i sum = zero;
+        for (int i = 0; i < Nnue::HIDDEN; i += LANES) {
+            __m256i activations = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + i));
+            activations = _mm256_min_epi16(_mm256_max_epi16(activations, zero), clip);
+            __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(activations, w)); //pairs of products summed into int32
+        }
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+        return _mm_cvtsi128_si32(half);
+    }
+#elif defined(__SSE4_1__)
+    const int LANES = 8;
+
+    void addColumn(int16_t* accumulator, const int16_t* column) {
+        for (int i = 0; i < Nnue::HIDDEN; i += LANES) {
+            __m128i sums = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            __m128i weights = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + i), _mm_add_epi16(sums, weights));
+        }
+    }
+
+    void subtractColumn(int16_t* accumulator, const int16_t* column) {
+        for (int i = 0; i < Nnue::HIDDEN; i += LANES) {
+            __m128i sums = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            __m128i weights = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + i), _mm_sub_epi16(sums, weights));
+        }
+    }
+
+    int32_t clippedDot(const int16_t* accumulator, const int16_t* weights) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i clip = _mm_set1_epi16(CLIP);
+        __m128i sum = zero;
+        for (int i = 0; i < Nnue::HIDDEN; i += LANES) {
+            __m128i activations = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            activations = _mm_min_epi16(_mm_max_epi16(activations, zero), clip);
+            __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(activations, w));
+        }
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+        return _mm_cvtsi128_si32(sum);
+    }
+#else
+    void addColumn(int16_t* accumulator, const int16_t* column) {
+        for (int i = 0; i < Nnue::HIDDEN; i++) {
+            accumulator[i] += column[i];
+        }
+    }
+
+    void subtractColumn(int16_t* accumulator, const int16_t* column) {
+        for (int i = 0; i < Nnue::HIDDEN; i++) {
+            accumulator[i] -= column[i];
+        }
+    }
+
+    int32_t clippedDot(const int16_t* accumulator, const int16_t* weights) {
+        int32_t sum = 0;
+        for (int i = 0; i < Nnue::HIDDEN; i++) {
+            int activation = accumulator[i] < 0 ? 0 : (accumulator[i] > CLIP ? CLIP : accumulator[i]);
+            sum += activation * weights[i];
+        }
+        return sum;
+    }
+#endif
+
+    template <typename T> bool read(std::ifstream& in, T* values, size_t count) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(values), sizeof(T) * count));
+    }
+}
+
+Nnue::Network::Network():
+    featureWeights(INPUTS * HIDDEN, 0), featureBias(HIDDEN, 0), outputWeights(2 * HIDDEN, 0), outputBias{0} {}
+
+bool Nnue::Network::load(const std::string& path) {
+    std::ifstream in{path, std::ios::binary};
+    char magic[8];
+    int32_t hidden;
+    if (!read(in, magic, 8) || std::memcmp(magic, MAGIC, 8) != 0 || !read(in, &hidden, 1) || hidden != HIDDEN) {
+        return false;
+    }
+
+    //read into copies so a truncated file leaves the current weights alone
+    std::vector<int16_t> newFeatureWeights(INPUTS * HIDDEN);
+    std::vector<int16_t> newFeatureBias(HIDDEN);
+    std::vector<int16_t> newOutputWeights(2 * HIDDEN);
+    int32_t newOutputBias;
+    if (!read(in, newFeatureWeights.data(), newFeatureWeights.size()) || !read(in, newFeatureBias.data(), newFeatureBias.size())
+        || !read(in, newOutputWeights.data(), newOutputWeights.size()) || !read(in, &newOutputBias, 1)) {
+        return false;
+    }
+    if (in.peek() != std::ifstream::traits_type::eof()) {
+        return false; //trailing data: not a network of this shape
+    }
+
+    featureWeights.swap(newFeatureWeights);
+    featureBias.swap(newFeatureBias);
+    outputWeights.swap(newOutputWeights);
+    outputBias = newOutputBias;
+    return true;
+}
+
+int Nnue::Network::input(int perspective, int code, Square square) {
+    if (perspective == 0) {
+        return code * Bitboards::NUM_SQUARES + square;
+    }
+    //black sees the board from the other side: colours swapped, ranks mirrored
+    return ((code + 6) % 12) * Bitboards::NUM_SQUARES + (square ^ 56);
+}
+
+void Nnue::Network::clear(Accumulator& accumulator) const {
+    for (int perspective = 0; perspective < 2; perspective++) {
+        std::memcpy(accumulator.values[perspective], featureBias.data(), sizeof(int16_t) * HIDDEN);
+    }
+}
+
+void Nnue::Network::addPiece(Accumulator& accumulator, int code, Square square) const {
+    for (int perspective = 0; perspective < 2; perspective++) {
+        addColumn(accumulator.values[perspective], &featureWeights[input(perspective, code, square) * HIDDEN]);
+    }
+}
+
+void Nnue::Network::removePiece(Accumulator& accumulator, int code, Square square) const {
+    for (int perspective = 0; perspective < 2; perspective++) {
+        subtractColumn(accumulator.values[perspective], &featureWeights[input(perspective, code, square) * HIDDEN]);
+    }
+}
+
+int Nnue::Network::evaluate(const Accumulator& accumulator, Colour sideToMove) const {
+    int us = Bitboards::colourIndex(sideToMove);
+    int64_t output = outputBias
+        + clippedDot(accumulator.values[us], &outputWeights[0])
+        + clippedDot(accumulator.values[1 - us], &outputWeights[HIDDEN]);
+    return static_cast<int>(output * OUTPUT_SCALE / (CLIP * OUTPUT_QUANTIZATION));
+}
+
+const char* Nnue::backend() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE4_1__)
+    return "sse4.1";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,59 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "bitboard.h"
+#include "../shared/colour.h"
+
+// A small efficiently updatable neural network (NNUE) evaluator. Each side's perspective has 768 inputs,
+// one per piece code and square, feeding a HIDDEN wide first layer. Its sums (the accumulator) are kept
+// up to date by Board as pieces are put and cleared, so a move costs a few vector adds instead of a full
+// first layer. The output is a clipped ReLU of both perspectives (side to move first) into a single neuron.
+// All weights are quantized to int16. The kernels use AVX2 or SSE4.1 when the build enables them
+// (the makefile's ARCH=-march=native does on cpus that have them), like the PEXT attacks in bitboard.cc,
+// with a scalar fallback otherwise (make ARCH=).
+namespace Nnue {
+    const int INPUTS = 12 * Bitboards::NUM_SQUARES;
+    const int HIDDEN = 128;
+
+    struct Accumulator {
+        int16_t values[2][HIDDEN]; //indexed by [Bitboards::colourIndex of the perspective][hidden unit]
+    };
+
+    // Weights file, little endian:
+    //   char magic[8] = "CHNNUE01"
+    //   int32 hidden, must equal HIDDEN
+    //   int16 featureWeights[INPUTS][HIDDEN], input = piece code * 64 + square as seen from the perspective's side
+    //   int16 featureBias[HIDDEN]
+    //   int16 outputWeights[2][HIDDEN], the side to move's half first
+    //   int32 outputBias
+    // The first layer is clipped to [0, 255] and the evaluation is (outputBias + output sum) * 400 / (255 * 64) centipawns,
+    // i.e. the output weights are quantized by 64.
+    // An input is the Board piece code (colour * 6 + piece type) with the colours swapped and the board mirrored
+    // for black's perspective, so one set of weights serves both sides.
+    class Network {
+        public:
+            Network(); //CTOR, every weight zero
+
+            bool load(const std::string& path); //false, leaving the network unchanged, if the file is missing or malformed
+
+            void clear(Accumulator& accumulator) const; //the accumulator of an empty board
+            void addPiece(Accumulator& accumulator, int code, Square square) const;
+            void removePiece(Accumulator& accumulator, int code, Square square) const;
+            int evaluate(const Accumulator& accumulator, Colour sideToMove) const; //centipawns for the side to move
+
+        private:
+            std::vector<int16_t> featureWeights; //INPUTS * HIDDEN, one HIDDEN wide column per input
+            std::vector<int16_t> featureBias;
+            std::vector<int16_t> outputWeights; //2 * HIDDEN
+            int32_t outputBias;
+
+            static int input(int perspective, int code, Square square);
+    };
+
+    const char* backend(); //"avx2", "sse4.1" or "scalar", whichever kernels were compiled in
+}
+
+#endif
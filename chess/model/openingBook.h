@@ -0,0 +1,50 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include "mappedFile.h"
+#include "move.h"
+#include "moveList.h"
+#include "zobrist.h"
+class Board;
+
+// Opening book in the Polyglot .bin format: 16 byte big endian entries (key, move, weight, learn) sorted by key.
+// The file is memory mapped and looked up by binary search, so opening a book costs nothing up front and a
+// lookup only touches the pages it needs.
+//
+// Keys are Polyglot's (its Random64 numbers for piece/square, castling, the en passant file only when a capture
+// is possible, and white to move), so standard Polyglot books and those written by tools/book.cc both work.
+// The starting position's key is 0x463b96181691fc9c.
+class OpeningBook {
+    public:
+        struct Entry {
+            Key key;
+            uint16_t move; //Polyglot encoding, see encodeMove
+            uint16_t weight;
+            uint32_t learn;
+        };
+        static const size_t ENTRY_SIZE = 16; //bytes on disk
+
+        bool open(const std::string& path); //false if the file can't be mapped or isn't a whole number of entries
+        void close();
+        bool isOpen() const;
+        size_t size() const; //number of entries
+
+        MoveList getMoves(const Board& board) const; //legal book moves for the side to move, scored by weight
+        Move pickMove(const Board& board, std::mt19937& rng) const; //random book move with probability by weight, null if none
+
+        static Key key(const Board& board);
+        static uint16_t encodeMove(Move move); //castling is encoded as the king taking its own rook
+        static void writeEntry(unsigned char* bytes, const Entry& entry); //ENTRY_SIZE bytes, big endian
+
+    private:
+        MappedFile file;
+
+        Entry entryAt(size_t index) const;
+        size_t lowerBound(Key key) const; //index of the first entry with a key not less than key
+};
+
+#endif
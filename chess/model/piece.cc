@@ -1,5 +1,11 @@
 #include "piece.h"
 #include "./board.h"
+#include "./pieces/pawn.h"
+#include "./pieces/rook.h"
+#include "./pieces/knight.h"
+#include "./pieces/bishop.h"
+#include "./pieces/queen.h"
+#include "./pieces/king.h"
 
 Piece::Piece(Coordinate::Coordinate position, Colour colour, PieceType pieceType, Board* board) 
     : position{position}, colour{colour}, board{board}, pieceType{pieceType} {}
@@ -8,16 +14,28 @@ std::unique_ptr<Piece> Piece::clone() {
     return std::unique_ptr<Piece>(cloneImpl());
 }
 
-Piece* Piece::cloneToBoard(Board* b) {
-    Piece* c = cloneImpl();
-    c->board = b;
-    return c;
-}
-
 Piece::PieceType Piece::getPieceType() const {
     return pieceType;
 }
 
+int Piece::valueOf(PieceType type) {
+    switch (type) {
+        case PieceType::Pawn:
+            return Pawn::VALUE;
+        case PieceType::Rook:
+            return Rook::VALUE;
+        case PieceType::Knight:
+            return Knight::VALUE;
+        case PieceType::Bishop:
+            return Bishop::VALUE;
+        case PieceType::Queen:
+            return Queen::VALUE;
+        case PieceType::King:
+            return King::VALUE;
+    }
+    return 0;
+}
+
 Coordinate::Coordinate Piece::getPosition() const {
     return position;
 }
@@ -26,46 +44,31 @@ Colour Piece::getColour() const {
     return colour;
 }
 
-bool Piece::makeMove(Coordinate::Coordinate dest, bool simulate) {
-    if (!simulate) {
-        std::vector<Coordinate::Coordinate> validMoves = getValidMoves();
-        if (std::find(validMoves.begin(), validMoves.end(), dest) == validMoves.end()) {
-            return false;
-        }
-    }
-
-    adjustAfterMove(dest, simulate);
-    position = dest;
-
-    return true;
-}
-
-void Piece::adjustAfterMove(Coordinate::Coordinate, bool) {
-    return;
-}
-
-int Piece::getMovementData() const {
-    return 0;
+MoveList Piece::getValidLegalMoves() const {
+    return board->generateLegalMoves(colour, Bitboards::squareBB(Bitboards::toSquare(position)));
 }
 
-std::vector<Coordinate::Coordinate> Piece::getValidLegalMoves() const {
-    std::vector<Coordinate::Coordinate> validLegalMoves;
-    for (Coordinate::Coordinate nextPos : getValidMoves()) {
-        if (board->takeTurn(position, nextPos, colour, true)) {
-            validLegalMoves.push_back(nextPos);
-        }
+MoveList Piece::movesTo(Bitboard targets) const {
+    MoveList moves;
+    Square from = Bitboards::toSquare(position);
+    while (targets) {
+        Square to = Bitboards::popLsb(targets);
+        moves.push(Move{from, to, (board->getOccupied() & Bitboards::squareBB(to)) ? Move::Capture : Move::Quiet});
     }
-    return validLegalMoves;
+    return moves;
 }
 
 bool Piece::canTargetSquare(Coordinate::Coordinate square) const {
-    std::vector<Coordinate::Coordinate> validMoves = getValidMoves();
-    if (std::find(validMoves.begin(), validMoves.end(), square) == validMoves.end()) { //square is not in valid moves
+    if (!Coordinate::checkBounds(square, board->getBoardDimension())) {
         return false;
     }
-    else {
-        return true;
+    Square target = Bitboards::toSquare(square);
+    for (const Move& move : getValidMoves()) {
+        if (move.to() == target) {
+            return true;
+        }
     }
+    return false;
 }
 
 bool Piece::canTargetSquareFrom(Coordinate::Coordinate from, Coordinate::Coordinate square) {
@@ -1,13 +1,13 @@
 #ifndef PIECE_H
 #define PIECE_H
 
-#include <vector>
 #include <memory>
-#include <algorithm>
+#include "bitboard.h"
 #include "../shared/colour.h"
 #include "../shared/coordinate.h"
 
 class Board;
+class MoveList;
 
 class Piece {
 public:
@@ -25,27 +25,25 @@ public:
     virtual ~Piece() = default;
 
     std::unique_ptr<Piece> clone();
-    Piece* cloneToBoard(Board* b);
 
     PieceType getPieceType() const;
+    static int valueOf(PieceType type); //same as toValue() without needing an instance
     virtual char toChar() const = 0;
     virtual int toValue() const = 0;
     Coordinate::Coordinate getPosition() const;
     Colour getColour() const;
     
-    virtual std::vector<Coordinate::Coordinate> getValidMoves() const = 0; //does not check if move will put Colour in check
-    virtual std::vector<Coordinate::Coordinate> getValidLegalMoves() const; //uses virtual method getValidMoves()
+    virtual MoveList getValidMoves() const = 0; //does not check if move will put Colour in check
+    MoveList getValidLegalMoves() const; //this piece's share of Board::generateLegalMoves()
     virtual bool canTargetSquare(Coordinate::Coordinate square) const; //uses virtual method getValidMoves()
     virtual bool canTargetSquareFrom(Coordinate::Coordinate from, Coordinate::Coordinate square); //uses virtual method canTargetSquare()
-    virtual int getMovementData() const;
-    bool makeMove(Coordinate::Coordinate dest, bool simulate = false);
 protected:
     Coordinate::Coordinate position;
     Colour colour;
     Board* board;
 
     virtual Piece* cloneImpl() = 0;
-    virtual void adjustAfterMove(Coordinate::Coordinate dest, bool simulate = false);
+    MoveList movesTo(Bitboard targets) const; //one move from position to each target square, flagged as a capture if occupied
 private:
     PieceType pieceType;
 };
@@ -20,11 +20,26 @@ public:
         return T::VALUE;
     }   
 
+    //T's piece-square bonus for a piece of colour on square, black reads the tables mirrored
+    static int middlegameBonus(Colour colour, Square square) {
+        return T::MIDDLEGAME_TABLE[tableIndex(colour, square)];
+    }
+
+    static int endgameBonus(Colour colour, Square square) {
+        return T::ENDGAME_TABLE[tableIndex(colour, square)];
+    }
+
     virtual ~PieceClonable() = 0;
 protected:
     Piece* cloneImpl() override {
         return new T{*static_cast<T*>(this)};
     }
+
+private:
+    static int tableIndex(Colour colour, Square square) {
+        //the tables start at a8, so a white piece's rank is flipped (square ^ 56) and a black piece's is used as is
+        return colour == Colour::White ? square ^ 56 : square;
+    }
 };
 
 template <typename T> PieceClonable<T>::~PieceClonable() {}
@@ -0,0 +1,47 @@
+#include "pieceSquare.h"
+#include "piece.h"
+#include "./pieces/pawn.h"
+#include "./pieces/rook.h"
+#include "./pieces/knight.h"
+#include "./pieces/bishop.h"
+#include "./pieces/queen.h"
+#include "./pieces/king.h"
+
+int PieceSquare::middlegame[12][Bitboards::NUM_SQUARES];
+int PieceSquare::endgame[12][Bitboards::NUM_SQUARES];
+int PieceSquare::material[12];
+int PieceSquare::phase[12];
+
+namespace {
+    //fills the entries of both colours of piece T from its traits, material is added to every square
+    template <typename T> void fillTables(Piece::PieceType type) {
+        for (int c = 0; c < 2; c++) {
+            Colour colour = c == 0 ? Colour::White : Colour::Black;
+            int code = c * 6 + static_cast<int>(type);
+            int sign = c == 0 ? 1 : -1;
+
+            PieceSquare::material[code] = type == Piece::PieceType::King ? 0 : T::VALUE * 100;
+            PieceSquare::phase[code] = T::PHASE;
+            for (int square = 0; square < Bitboards::NUM_SQUARES; square++) {
+                PieceSquare::middlegame[code][square] = sign * (PieceSquare::material[code] + T::middlegameBonus(colour, square));
+                PieceSquare::endgame[code][square] = sign * (PieceSquare::material[code] + T::endgameBonus(colour, square));
+            }
+        }
+    }
+}
+
+void PieceSquare::init() {
+    static bool initialized = false;
+    if (initialized) {
+        return;
+    }
+
+    fillTables<King>(Piece::PieceType::King);
+    fillTables<Queen>(Piece::PieceType::Queen);
+    fillTables<Bishop>(Piece::PieceType::Bishop);
+    fillTables<Rook>(Piece::PieceType::Rook);
+    fillTables<Knight>(Piece::PieceType::Knight);
+    fillTables<Pawn>(Piece::PieceType::Pawn);
+
+    initialized = true;
+}
@@ -0,0 +1,20 @@
+#ifndef PIECESQUARE_H
+#define PIECESQUARE_H
+
+#include "bitboard.h"
+
+// Evaluation terms for a piece standing on a square, which Board keeps summed as pieces are put and cleared,
+// so evaluating a position costs a few additions. Scores are centipawns from white's point of view
+// (black's entries are negated), with a middlegame and an endgame value blended by the game phase.
+namespace PieceSquare {
+    const int MAX_PHASE = 24; //phase with every knight, bishop, rook and queen still on the board
+
+    extern int middlegame[12][Bitboards::NUM_SQUARES]; //indexed by Board's piece code (colour * 6 + piece type), material included
+    extern int endgame[12][Bitboards::NUM_SQUARES];
+    extern int material[12]; //centipawns, unsigned, 0 for kings
+    extern int phase[12]; //how much the piece counts towards MAX_PHASE
+
+    void init(); //built from each piece's traits (VALUE, PHASE and its tables), safe to call more than once
+}
+
+#endif
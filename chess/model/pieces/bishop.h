@@ -10,12 +10,34 @@ private:
 public:
     static const char SYMBOL = 'B';
     static const int VALUE = 3;
+    static const int PHASE = 1; //weight towards PieceSquare::MAX_PHASE
+    //centipawn bonus per square for a white bishop, laid out like the printed board (a8 first, h1 last)
+    static constexpr int MIDDLEGAME_TABLE[64] = {
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   5,   5,  10,  10,   5,   5, -10,
+        -10,   0,  10,  10,  10,  10,   0, -10,
+        -10,  10,  10,  10,  10,  10,  10, -10,
+        -10,   5,   0,   0,   0,   0,   5, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20
+    };
+    static constexpr int ENDGAME_TABLE[64] = {
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20
+    };
 
     Bishop(Coordinate::Coordinate position, Colour colour, Board* board);
 
     ~Bishop() = default;
 
-    std::vector<Coordinate::Coordinate> getValidMoves() const override;
+    MoveList getValidMoves() const override;
 };
 
 #endif
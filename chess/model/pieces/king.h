@@ -6,19 +6,39 @@
 
 class King : public PieceClonable<King> {
 private:
-    bool hasMoved;
+
 public:
     static const char SYMBOL = 'K';
     static const int VALUE = 1000;
+    static const int PHASE = 0; //weight towards PieceSquare::MAX_PHASE
+    //centipawn bonus per square for a white king, laid out like the printed board (a8 first, h1 last)
+    static constexpr int MIDDLEGAME_TABLE[64] = {
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+         20,  20,   0,   0,   0,   0,  20,  20,
+         20,  30,  10,   0,   0,  10,  30,  20
+    };
+    static constexpr int ENDGAME_TABLE[64] = {
+        -50, -40, -30, -20, -20, -30, -40, -50,
+        -30, -20, -10,   0,   0, -10, -20, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -30,   0,   0,   0,   0, -30, -30,
+        -50, -30, -30, -30, -30, -30, -30, -50
+    };
 
     King(Coordinate::Coordinate position, Colour colour, Board* board);
 
     ~King() = default;
 
-    std::vector<Coordinate::Coordinate> getValidLegalMoves() const override;
-    std::vector<Coordinate::Coordinate> getValidMoves() const override;
+    MoveList getValidMoves() const override;
     bool canTargetSquare(Coordinate::Coordinate square) const;
-    void adjustAfterMove(Coordinate::Coordinate dest, bool simulate = false) override;
 };
 
 #endif
@@ -10,12 +10,34 @@ private:
 public:
     static const char SYMBOL = 'N';
     static const int VALUE = 3;
+    static const int PHASE = 1; //weight towards PieceSquare::MAX_PHASE
+    //centipawn bonus per square for a white knight, laid out like the printed board (a8 first, h1 last)
+    static constexpr int MIDDLEGAME_TABLE[64] = {
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   0,  15,  20,  20,  15,   0, -30,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50
+    };
+    static constexpr int ENDGAME_TABLE[64] = {
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -30,   0,  10,  10,  10,  10,   0, -30,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   0,  10,  10,  10,  10,   0, -30,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50
+    };
 
     Knight(Coordinate::Coordinate position, Colour colour, Board* board);
 
     ~Knight() = default;
 
-    std::vector<Coordinate::Coordinate> getValidMoves() const override;
+    MoveList getValidMoves() const override;
 };
 
 #endif
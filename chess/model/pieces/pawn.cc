@@ -2,11 +2,34 @@
 #include "../board.h"
 #include <cmath>
 
+constexpr int Pawn::MIDDLEGAME_TABLE[64];
+constexpr int Pawn::ENDGAME_TABLE[64];
+
 Pawn::Pawn(Coordinate::Coordinate position, Colour colour, Board* board) 
-    : PieceClonable{position, colour, Piece::PieceType::Pawn, board}, hasMoved{false}, justMovedTwice{false} {}
+    : PieceClonable{position, colour, Piece::PieceType::Pawn, board} {}
+
+namespace {
+    //pushes one move per promotion piece when to is on the last rank
+    void pushPawnMove(MoveList& moves, Square from, Square to, int flags, int dim) {
+        int row = Bitboards::toCoordinate(to).row;
+        if (row == 0 || row == dim - 1) {
+            const Piece::PieceType promotions[4] = {
+                Piece::PieceType::Queen, Piece::PieceType::Rook, Piece::PieceType::Bishop, Piece::PieceType::Knight
+            };
+            for (Piece::PieceType type : promotions) {
+                moves.push(Move{from, to, Move::promotionFlag(type) | flags});
+            }
+        }
+        else {
+            moves.push(Move{from, to, flags});
+        }
+    }
+}
 
-std::vector<Coordinate::Coordinate> Pawn::getValidMoves() const {
-    std::vector<Coordinate::Coordinate> validMoves;
+MoveList Pawn::getValidMoves() const {
+    MoveList validMoves;
+    int dim = board->getBoardDimension();
+    Square from = Bitboards::toSquare(position);
 
     int twoOffset = colour == Colour::White ? 2 : -2;
     int oneOffset = colour == Colour::White ? 1 : -1;
@@ -16,44 +39,30 @@ std::vector<Coordinate::Coordinate> Pawn::getValidMoves() const {
     Coordinate::Coordinate c3{position.row + oneOffset, position.col + oneOffset}; // Diagonal right
     Coordinate::Coordinate c4{position.row + oneOffset, position.col - oneOffset}; // Diagonal left
 
-    if (!hasMoved && Coordinate::checkBounds(c2, board->getBoardDimension()) && Coordinate::checkBounds(c1, board->getBoardDimension())
-        && !board->getPiece(c2) && !board->getPiece(c1)) {
-        validMoves.push_back(c2);
+    bool onStartingRank = position.row == (colour == Colour::White ? 1 : board->getBoardDimension() - 2);
+    if (onStartingRank && Coordinate::checkBounds(c2, board->getBoardDimension()) && Coordinate::checkBounds(c1, board->getBoardDimension())
+        && !board->isOccupied(c2) && !board->isOccupied(c1)) {
+        validMoves.push(Move{from, Bitboards::toSquare(c2), Move::DoublePush});
     }
 
-    if (Coordinate::checkBounds(c1, board->getBoardDimension()) && !board->getPiece(c1)) {
-        validMoves.push_back(c1);
+    if (Coordinate::checkBounds(c1, board->getBoardDimension()) && !board->isOccupied(c1)) {
+        pushPawnMove(validMoves, from, Bitboards::toSquare(c1), Move::Quiet, dim);
     }
 
-    if (Coordinate::checkBounds(c3, board->getBoardDimension()) && board->getPiece(c3) 
-        && board->getPiece(c3)->getColour() != colour) {
-        validMoves.push_back(c3);
+    if (board->isOccupied(c3) && board->getColourAt(c3) != colour) {
+        pushPawnMove(validMoves, from, Bitboards::toSquare(c3), Move::Capture, dim);
     }
 
-    if (Coordinate::checkBounds(c4, board->getBoardDimension()) && board->getPiece(c4) 
-        && board->getPiece(c4)->getColour() != colour) {
-        validMoves.push_back(c4);
+    if (board->isOccupied(c4) && board->getColourAt(c4) != colour) {
+        pushPawnMove(validMoves, from, Bitboards::toSquare(c4), Move::Capture, dim);
     }
 
-    // En passant
-    Coordinate::Coordinate leftAdjacent{position.row, position.col - 1};
-    Coordinate::Coordinate rightAdjacent{position.row, position.col + 1};
-
-    if (Coordinate::checkBounds(leftAdjacent, board->getBoardDimension())) {
-        std::unique_ptr<Piece> leftPiece = board->getPiece(leftAdjacent);
-        if (leftPiece && leftPiece->getColour() != colour && leftPiece->getPieceType() == Piece::PieceType::Pawn) {
-            if (leftPiece->getMovementData() == 1) {
-                validMoves.push_back(Coordinate::Coordinate{position.row + oneOffset, position.col - 1});
-            }
-        }
-    }
-    if (Coordinate::checkBounds(rightAdjacent, board->getBoardDimension())) {
-        std::unique_ptr<Piece> rightPiece = board->getPiece(rightAdjacent);
-        if (rightPiece && rightPiece->getColour() != colour && rightPiece->getPieceType() == Piece::PieceType::Pawn) {
-            if (rightPiece->getMovementData() == 1) {
-                validMoves.push_back(Coordinate::Coordinate{position.row + oneOffset, position.col + 1});
-            }
-        }
+    // En passant (the target square lies behind an enemy pawn that just moved two squares)
+    Coordinate::Coordinate enPassantTarget = board->getEnPassantTarget();
+    int enPassantRow = colour == Colour::White ? board->getBoardDimension() - 3 : 2;
+    if (enPassantTarget.row == enPassantRow && enPassantTarget.row == position.row + oneOffset
+        && std::abs(enPassantTarget.col - position.col) == 1) {
+        validMoves.push(Move{from, Bitboards::toSquare(enPassantTarget), Move::EnPassant});
     }
 
     return validMoves;
@@ -71,17 +80,23 @@ bool Pawn::canTargetSquare(Coordinate::Coordinate square) const {
     return false;
 }
 
-void Pawn::adjustAfterMove(Coordinate::Coordinate dest, bool) {
-    hasMoved = true;
-    justMovedTwice = std::abs(dest.row - position.row) == 2;
+Bitboard Pawn::fileMask(Square square) {
+    return Bitboards::FILE_A << (square % 8);
 }
 
-int Pawn::getMovementData() const {
-    if (justMovedTwice)
-        return 1;
-    return 0;
+Bitboard Pawn::adjacentFiles(Square square) {
+    Bitboard file = fileMask(square);
+    return ((file & ~Bitboards::FILE_H) << 1) | ((file & ~Bitboards::FILE_A) >> 1);
+}
+
+Bitboard Pawn::forwardRanks(Colour colour, Square square) {
+    int row = square / 8;
+    if (colour == Colour::White) {
+        return row == 7 ? 0 : ~0ULL << (8 * (row + 1));
+    }
+    return row == 0 ? 0 : ~0ULL >> (8 * (8 - row));
 }
 
-void Pawn::falsifyJustMovedTwice() {
-    justMovedTwice = false;
+Bitboard Pawn::passedMask(Colour colour, Square square) {
+    return forwardRanks(colour, square) & (fileMask(square) | adjacentFiles(square));
 }
@@ -6,21 +6,45 @@
 
 class Pawn : public PieceClonable<Pawn> {
 private:
-    bool hasMoved;
-    bool justMovedTwice;
+
 public:
     static const char SYMBOL = 'P';
     static const int VALUE = 1;
+    static const int PHASE = 0; //weight towards PieceSquare::MAX_PHASE
+    //centipawn bonus per square for a white pawn, laid out like the printed board (a8 first, h1 last)
+    static constexpr int MIDDLEGAME_TABLE[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         10,  10,  20,  30,  30,  20,  10,  10,
+          5,   5,  10,  25,  25,  10,   5,   5,
+          0,   0,   0,  20,  20,   0,   0,   0,
+          5,  -5, -10,   0,   0, -10,  -5,   5,
+          5,  10,  10, -20, -20,  10,  10,   5,
+          0,   0,   0,   0,   0,   0,   0,   0
+    };
+    static constexpr int ENDGAME_TABLE[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         80,  80,  80,  80,  80,  80,  80,  80,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         30,  30,  30,  30,  30,  30,  30,  30,
+         15,  15,  15,  15,  15,  15,  15,  15,
+          5,   5,   5,   5,   5,   5,   5,   5,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0
+    };
 
     Pawn(Coordinate::Coordinate position, Colour colour, Board* board);
 
     ~Pawn() = default;
 
-    std::vector<Coordinate::Coordinate> getValidMoves() const override;
+    MoveList getValidMoves() const override;
     bool canTargetSquare(Coordinate::Coordinate square) const override;
-    void adjustAfterMove(Coordinate::Coordinate dest, bool simulate = false) override;
-    int getMovementData() const override;
-    void falsifyJustMovedTwice();
+
+    //pawn structure masks for a pawn of colour on square, "in front" meaning towards the promotion rank
+    static Bitboard fileMask(Square square);
+    static Bitboard adjacentFiles(Square square);
+    static Bitboard forwardRanks(Colour colour, Square square); //every rank in front of square
+    static Bitboard passedMask(Colour colour, Square square); //the pawn is passed if no enemy pawn is in front of it on its own or an adjacent file
 };
 
 #endif
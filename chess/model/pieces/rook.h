@@ -6,18 +6,38 @@
 
 class Rook : public PieceClonable<Rook> {
 private:
-    bool hasMoved;
+
 public:
     static const char SYMBOL = 'R';
     static const int VALUE = 5;
+    static const int PHASE = 2; //weight towards PieceSquare::MAX_PHASE
+    //centipawn bonus per square for a white rook, laid out like the printed board (a8 first, h1 last)
+    static constexpr int MIDDLEGAME_TABLE[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+          5,  10,  10,  10,  10,  10,  10,   5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+          0,   0,   0,   5,   5,   0,   0,   0
+    };
+    static constexpr int ENDGAME_TABLE[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         10,  10,  10,  10,  10,  10,  10,  10,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0
+    };
 
     Rook(Coordinate::Coordinate position, Colour colour, Board* board);
 
     ~Rook() = default;
 
-    std::vector<Coordinate::Coordinate> getValidMoves() const override;
-    void adjustAfterMove(Coordinate::Coordinate dest, bool simulate = false) override;
-    int getMovementData() const override;
+    MoveList getValidMoves() const override;
 };
 
 #endif
@@ -0,0 +1,123 @@
+#include "tablebase.h"
+#include "board.h"
+#include <cstring>
+
+namespace {
+    const char MAGIC[8] = {'C', 'H', 'T', 'B', '0', '0', '0', '1'};
+    const char* NAMES[Tablebase::NUM_SETS] = {"KQK", "KRK", "KPK"};
+}
+
+int Tablebase::open(const std::string& directory) {
+    close();
+
+    int opened = 0;
+    for (int i = 0; i < NUM_SETS; i++) {
+        Set set = static_cast<Set>(i);
+        if (!tables[i].open(directory + "/" + fileName(set))) {
+            continue;
+        }
+        unsigned char expected[HEADER_SIZE];
+        writeHeader(expected, set);
+        //a truncated file, another version, or a table renamed to another set
+        if (tables[i].size() != HEADER_SIZE + TABLE_SIZE || std::memcmp(tables[i].data(), expected, HEADER_SIZE) != 0) {
+            tables[i].close();
+            continue;
+        }
+        opened++;
+    }
+    return opened;
+}
+
+void Tablebase::close() {
+    for (int i = 0; i < NUM_SETS; i++) {
+        tables[i].close();
+    }
+}
+
+bool Tablebase::isOpen(Set set) const {
+    return tables[set].isOpen();
+}
+
+bool Tablebase::probe(const Board& board, Result& result) const {
+    Bitboard occupied = board.getOccupied();
+    int count = Bitboards::popCount(occupied);
+    if (count > 3) {
+        return false;
+    }
+    if (board.hasCastlingRight(Board::CastlingRight::WhiteKingSide) || board.hasCastlingRight(Board::CastlingRight::WhiteQueenSide) ||
+        board.hasCastlingRight(Board::CastlingRight::BlackKingSide) || board.hasCastlingRight(Board::CastlingRight::BlackQueenSide)) {
+        return false; //the tables assume neither side can castle
+    }
+
+    Bitboard kings = board.getPieces(Colour::White, Piece::PieceType::King) | board.getPieces(Colour::Black, Piece::PieceType::King);
+    Bitboard others = occupied & ~kings;
+    if (count == 2 || !others) {
+        result = Result{Wdl::Draw, 0}; //bare kings
+        return true;
+    }
+
+    Square piece = Bitboards::lsb(others);
+    Piece::PieceType type = board.getPieceTypeAt(piece);
+    Set set;
+    switch (type) {
+        case Piece::PieceType::Queen: set = KQK; break;
+        case Piece::PieceType::Rook: set = KRK; break;
+        case Piece::PieceType::Pawn: set = KPK; break;
+        default: //a lone bishop or knight can't mate
+            result = Result{Wdl::Draw, 0};
+            return true;
+    }
+    if (!tables[set].isOpen()) {
+        return false;
+    }
+
+    //the tables hold the extra piece as white's, so black's is looked up on the board mirrored top to bottom with the colours swapped
+    Colour strong = board.getColourAt(Bitboards::toCoordinate(piece));
+    Colour sideToMove = board.getSideToMove();
+    Square whiteKing = Bitboards::lsb(board.getPieces(Colour::White, Piece::PieceType::King));
+    Square blackKing = Bitboards::lsb(board.getPieces(Colour::Black, Piece::PieceType::King));
+    size_t i;
+    if (strong == Colour::White) {
+        i = index(sideToMove, whiteKing, blackKing, piece);
+    }
+    else {
+        Colour mirrored = sideToMove == Colour::White ? Colour::Black : Colour::White;
+        i = index(mirrored, blackKing ^ 56, whiteKing ^ 56, piece ^ 56);
+    }
+
+    uint8_t value = tables[set].data()[HEADER_SIZE + i];
+    if (value == ILLEGAL) {
+        return false;
+    }
+    result = decode(value);
+    return true;
+}
+
+std::string Tablebase::fileName(Set set) {
+    return std::string{NAMES[set]} + ".tb";
+}
+
+void Tablebase::writeHeader(unsigned char* header, Set set) {
+    std::memset(header, 0, HEADER_SIZE);
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    header[sizeof(MAGIC)] = static_cast<unsigned char>(set);
+}
+
+size_t Tablebase::index(Colour sideToMove, Square whiteKing, Square blackKing, Square piece) {
+    return ((static_cast<size_t>(Bitboards::colourIndex(sideToMove)) * 64 + whiteKing) * 64 + blackKing) * 64 + piece;
+}
+
+uint8_t Tablebase::encode(const Result& result) {
+    if (result.wdl == Wdl::Draw) {
+        return DRAW;
+    }
+    return static_cast<uint8_t>(result.pliesToMate + 1);
+}
+
+Tablebase::Result Tablebase::decode(uint8_t value) {
+    if (value == DRAW) {
+        return Result{Wdl::Draw, 0};
+    }
+    int plies = value - 1;
+    return Result{plies % 2 == 1 ? Wdl::Win : Wdl::Loss, plies}; //the side to move mates on odd plies, is mated on even ones
+}
@@ -0,0 +1,50 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "bitboard.h"
+#include "mappedFile.h"
+#include "../shared/colour.h"
+class Board;
+
+// Endgame tablebases for king and queen, king and rook, and king and pawn against a lone king, generated by
+// tools/tbgen.cc and memory mapped here. Each table holds one byte per position: DRAW, ILLEGAL, or the number of
+// plies to mate plus one. An odd distance means the side to move mates, an even one that it gets mated.
+// Positions are indexed with the side holding the extra piece as white (black's are mirrored), so a table
+// covers both colours. Bare kings and a lone minor piece are always drawn and need no table.
+class Tablebase {
+    public:
+        enum Set { KQK, KRK, KPK, NUM_SETS };
+
+        enum class Wdl { Loss, Draw, Win }; //for the side to move
+
+        struct Result {
+            Wdl wdl;
+            int pliesToMate; //0 for draws
+        };
+
+        static const size_t TABLE_SIZE = 2 * 64 * 64 * 64; //side to move, white king, black king, extra piece
+        static const size_t HEADER_SIZE = 16; //"CHTB0001", then the Set as a byte, then zeros
+        static const uint8_t DRAW = 0;
+        static const uint8_t ILLEGAL = 255;
+
+        int open(const std::string& directory); //maps every table found in directory, returns how many
+        void close();
+        bool isOpen(Set set) const;
+
+        //false unless the position has the material of an open table (or is a trivial draw) and no castling rights
+        bool probe(const Board& board, Result& result) const;
+
+        static std::string fileName(Set set);
+        static void writeHeader(unsigned char* header, Set set); //HEADER_SIZE bytes
+        static size_t index(Colour sideToMove, Square whiteKing, Square blackKing, Square piece);
+        static uint8_t encode(const Result& result);
+        static Result decode(uint8_t value); //value must not be ILLEGAL
+
+    private:
+        MappedFile tables[NUM_SETS]; //closed for tables that weren't found
+};
+
+#endif
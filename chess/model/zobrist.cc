@@ -0,0 +1,51 @@
+#include "zobrist.h"
+
+Key Zobrist::pieceSquare[12][Bitboards::NUM_SQUARES];
+Key Zobrist::castlingRights[16];
+Key Zobrist::enPassantFile[8];
+Key Zobrist::blackToMove;
+
+namespace {
+    //splitmix64: every output is a well mixed 64-bit value, which is all Zobrist keys need
+    uint64_t nextKey(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+}
+
+void Zobrist::init() {
+    static bool initialized = false;
+    if (initialized) {
+        return;
+    }
+
+    uint64_t state = 1070372;
+    for (int code = 0; code < 12; code++) {
+        for (int square = 0; square < Bitboards::NUM_SQUARES; square++) {
+            pieceSquare[code][square] = nextKey(state);
+        }
+    }
+
+    //each right gets its own key and a mask hashes to the xor of its rights, so revoking one right is one xor
+    Key rightKeys[4];
+    for (int i = 0; i < 4; i++) {
+        rightKeys[i] = nextKey(state);
+    }
+    for (int rights = 0; rights < 16; rights++) {
+        castlingRights[rights] = 0;
+        for (int i = 0; i < 4; i++) {
+            if (rights & (1 << i)) {
+                castlingRights[rights] ^= rightKeys[i];
+            }
+        }
+    }
+
+    for (int file = 0; file < 8; file++) {
+        enPassantFile[file] = nextKey(state);
+    }
+    blackToMove = nextKey(state);
+
+    initialized = true;
+}
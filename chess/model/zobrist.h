@@ -0,0 +1,20 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+#include "bitboard.h"
+
+typedef uint64_t Key;
+
+// Random keys for Zobrist hashing: a position's key is the xor of the keys of everything in it,
+// so a move only has to xor out what it removes and xor in what it adds.
+namespace Zobrist {
+    extern Key pieceSquare[12][Bitboards::NUM_SQUARES]; //indexed by Board's piece code (colour * 6 + piece type)
+    extern Key castlingRights[16]; //indexed by the Board::CastlingRight mask, no rights hash to 0
+    extern Key enPassantFile[8];
+    extern Key blackToMove;
+
+    void init(); //fills the tables from a fixed seed so keys are the same on every run, safe to call more than once
+}
+
+#endif
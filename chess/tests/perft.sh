@@ -0,0 +1,25 @@
+#!/bin/sh
+# Checks move generation against the published perft counts of the standard test positions
+# (https://www.chessprogramming.org/Perft_Results). Run from anywhere: sh tests/perft.sh
+cd "$(dirname "$0")/.." || exit 1
+make -s perft || exit 1
+
+failed=0
+check() { # depth, expected nodes, FEN
+    nodes=$(./perft "$1" "$3" | sed -n 's/^Nodes searched: //p')
+    if [ "$nodes" = "$2" ]; then
+        echo "ok      depth $1 $nodes  $3"
+    else
+        echo "FAILED  depth $1 $nodes, expected $2  $3"
+        failed=1
+    fi
+}
+
+check 6 119060324 "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+check 5 193690690 "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"
+check 6 11030083 "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"
+check 5 15833292 "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"
+check 5 15833292 "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1"
+check 5 89941194 "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+check 5 164075551 "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"
+exit $failed
@@ -0,0 +1,25 @@
+#!/bin/sh
+# Generates the endgame tablebases and checks each table's won/drawn/lost counts and longest mate.
+# The longest mates are the known ones: KQK mates in 10 moves, KRK in 16 and KPK in 28, i.e. 20, 32
+# and 56 plies from the losing side's move. Run from anywhere: sh tests/tablebase.sh
+cd "$(dirname "$0")/.." || exit 1
+make -s tbgen || exit 1
+
+directory=$(mktemp -d) || exit 1
+trap 'rm -rf "$directory"' EXIT
+
+expected="KQK.tb: 144508 won, 23048 drawn, 200896 lost, longest mate 20 plies
+KRK.tb: 175168 won, 22244 drawn, 201700 lost, longest mate 32 plies
+KPK.tb: 124960 won, 108788 drawn, 97604 lost, longest mate 56 plies"
+
+actual=$(./tbgen "$directory") || exit 1
+if [ "$actual" = "$expected" ]; then
+    echo "$actual"
+    echo "ok"
+else
+    echo "FAILED, got:"
+    echo "$actual"
+    echo "expected:"
+    echo "$expected"
+    exit 1
+fi
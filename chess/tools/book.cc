@@ -0,0 +1,72 @@
+// book: builds an opening book in the Polyglot .bin format (see model/openingBook.h) from opening lines.
+// Usage: ./book <out.bin> [maxPly] < lines.txt
+// Each input line is a game or opening from the starting position in coordinate notation ("e2e4 e7e5 g1f3 b8c6"),
+// only its first maxPly moves (default 16) are used. Every position and move along a line is counted and a move's
+// weight is the number of times it was played, capped at 65535. A line stops at its first illegal move, which is reported.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "../model/board.h"
+#include "../model/openingBook.h"
+
+namespace {
+    const int DEFAULT_MAX_PLY = 16;
+    const uint32_t MAX_WEIGHT = 65535;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <out.bin> [maxPly] < lines.txt\n";
+        return 1;
+    }
+    int maxPly = argc > 2 ? std::atoi(argv[2]) : DEFAULT_MAX_PLY;
+
+    std::map<std::pair<Key, uint16_t>, uint32_t> counts; //sorted by key as the format requires
+    Board board{8};
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(std::cin, line)) {
+        ++lineNumber;
+        board.resetDefaultChess();
+        board.setSideToMove(Colour::White);
+
+        std::istringstream moves{line};
+        std::string token;
+        for (int ply = 0; ply < maxPly && moves >> token; ply++) {
+            Move played{};
+            for (Move move : board.generateLegalMoves(board.getSideToMove())) {
+                if (move.toString() == token) {
+                    played = move;
+                    break;
+                }
+            }
+            if (played.isNull()) {
+                std::cerr << "line " << lineNumber << ": illegal move " << token << ", rest of the line skipped\n";
+                break;
+            }
+
+            ++counts[std::make_pair(OpeningBook::key(board), OpeningBook::encodeMove(played))];
+            board.makeMove(played);
+        }
+    }
+
+    std::ofstream out{argv[1], std::ios::binary};
+    unsigned char bytes[OpeningBook::ENTRY_SIZE];
+    for (const auto& count : counts) {
+        OpeningBook::Entry entry{count.first.first, count.first.second, static_cast<uint16_t>(count.second < MAX_WEIGHT ? count.second : MAX_WEIGHT), 0};
+        OpeningBook::writeEntry(bytes, entry);
+        out.write(reinterpret_cast<const char*>(bytes), OpeningBook::ENTRY_SIZE);
+    }
+    if (!out) {
+        std::cerr << "could not write " << argv[1] << "\n";
+        return 1;
+    }
+
+    std::cout << counts.size() << " entries written to " << argv[1] << "\n";
+    return 0;
+}
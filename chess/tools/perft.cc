@@ -0,0 +1,70 @@
+// perft: counts the leaf nodes of the legal move tree to a fixed depth.
+// Usage: ./perft <depth> [fen]   (defaults to the starting position)
+// Prints the node count below each root move (divide) so mismatches against published numbers
+// can be narrowed down one move at a time, followed by the total and the node rate.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "../model/board.h"
+
+namespace {
+    const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    uint64_t perft(Board& board, int depth) {
+        MoveList moves = board.generateLegalMoves(board.getSideToMove());
+        if (depth == 1) { //bulk counting: every legal move is a leaf
+            return moves.size();
+        }
+
+        uint64_t nodes = 0;
+        for (Move move : moves) {
+            board.makeMove(move);
+            nodes += perft(board, depth - 1);
+            board.unmakeMove();
+        }
+        return nodes;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::atoi(argv[1]) < 1) {
+        std::cerr << "Usage: " << argv[0] << " <depth> [fen]\n";
+        return 1;
+    }
+
+    int depth = std::atoi(argv[1]);
+    std::string fen = START_FEN;
+    if (argc > 2) { //the FEN may be passed as one argument or as separate fields
+        fen = argv[2];
+        for (int i = 3; i < argc; i++) {
+            fen += std::string(" ") + argv[i];
+        }
+    }
+
+    Board board{8};
+    if (!board.loadFen(fen)) {
+        std::cerr << "Invalid FEN: " << fen << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t total = 0;
+    for (Move move : board.generateLegalMoves(board.getSideToMove())) {
+        uint64_t nodes = 1;
+        if (depth > 1) {
+            board.makeMove(move);
+            nodes = perft(board, depth - 1);
+            board.unmakeMove();
+        }
+        total += nodes;
+        std::cout << move.toString() << ": " << nodes << "\n";
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\nNodes searched: " << total << "\n";
+    std::cout << "Time: " << seconds << " s\n";
+    std::cout << "Nodes/second: " << static_cast<uint64_t>(seconds > 0 ? total / seconds : 0) << "\n";
+    return 0;
+}
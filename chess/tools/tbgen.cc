@@ -0,0 +1,267 @@
+// tbgen: generates the endgame tablebases read by model/tablebase.h (KQK, KRK and KPK) by retrograde analysis.
+// Usage: ./tbgen <directory>
+// Every placement of the two kings and the extra (white) piece is set up once, both sides to move, and its legal
+// moves are recorded. Checkmates are lost in 0 plies and stalemates drawn; then, ply by ply, a position is won in n
+// if some move reaches a position lost in n - 1, and lost in n if every move reaches a position won in n - 1 or
+// fewer. Positions still undecided when no more can be are draws. Captures of the extra piece are draws and so are
+// promotions to a bishop or knight, while promotions to a queen or rook are looked up in the tables built before KPK.
+// Prints the number of won, drawn and lost positions and the longest mate of each table.
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../model/board.h"
+#include "../model/tablebase.h"
+
+namespace {
+    const int16_t UNDECIDED = -1;
+    const int16_t DRAWN = -2;
+    const int16_t ILLEGAL = -3;
+
+    const char PIECE_CODES[Tablebase::NUM_SETS] = {'Q', 'R', 'P'};
+
+    std::string toFen(Colour sideToMove, Square whiteKing, Square blackKing, Square piece, char pieceCode) {
+        char squares[64];
+        for (int i = 0; i < 64; i++) {
+            squares[i] = 0;
+        }
+        squares[whiteKing] = 'K';
+        squares[blackKing] = 'k';
+        squares[piece] = pieceCode;
+
+        std::string fen;
+        for (int row = 7; row >= 0; row--) {
+            int empty = 0;
+            for (int col = 0; col < 8; col++) {
+                char c = squares[row * 8 + col];
+                if (!c) {
+                    ++empty;
+                    continue;
+                }
+                if (empty) {
+                    fen += static_cast<char>('0' + empty);
+                    empty = 0;
+                }
+                fen += c;
+            }
+            if (empty) {
+                fen += static_cast<char>('0' + empty);
+            }
+            if (row > 0) {
+                fen += '/';
+            }
+        }
+        return fen + (sideToMove == Colour::White ? " w - - 0 1" : " b - - 0 1");
+    }
+
+    //can the side to move take the other king? (also rules out positions the extra piece can't stand in)
+    bool isIllegal(Tablebase::Set set, Colour sideToMove, Square whiteKing, Square blackKing, Square piece) {
+        if (whiteKing == blackKing || piece == whiteKing || piece == blackKing) {
+            return true;
+        }
+        if (Bitboards::kingAttacks(whiteKing) & Bitboards::squareBB(blackKing)) {
+            return true;
+        }
+        if (set == Tablebase::KPK && (piece < 8 || piece >= 56)) {
+            return true;
+        }
+        if (sideToMove == Colour::Black) {
+            return false;
+        }
+        Bitboard occupied = Bitboards::squareBB(whiteKing) | Bitboards::squareBB(blackKing) | Bitboards::squareBB(piece);
+        Bitboard attacks = set == Tablebase::KQK ? Bitboards::queenAttacks(piece, occupied)
+                         : set == Tablebase::KRK ? Bitboards::rookAttacks(piece, occupied)
+                         : Bitboards::pawnAttacks(Colour::White, piece);
+        return attacks & Bitboards::squareBB(blackKing);
+    }
+
+    struct Generator {
+        Tablebase::Set set;
+        const std::vector<uint8_t>* promotions[Tablebase::NUM_SETS]; //finished tables, for KPK's promotions
+        std::vector<int16_t> plies; //per index: plies to mate, or one of the markers above
+        std::vector<uint32_t> firstChild; //children of index i are children[firstChild[i]] to children[firstChild[i + 1]]
+        std::vector<int32_t> children; //an index into this table, or -1 - the encoded result of a position outside it
+
+        void setUp(Board& board) {
+            plies.assign(Tablebase::TABLE_SIZE, ILLEGAL);
+            firstChild.assign(Tablebase::TABLE_SIZE + 1, 0);
+            children.clear();
+
+            for (size_t i = 0; i < Tablebase::TABLE_SIZE; i++) {
+                firstChild[i] = children.size();
+                Colour sideToMove = i < Tablebase::TABLE_SIZE / 2 ? Colour::White : Colour::Black;
+                Square whiteKing = (i >> 12) & 63;
+                Square blackKing = (i >> 6) & 63;
+                Square piece = i & 63;
+                if (isIllegal(set, sideToMove, whiteKing, blackKing, piece)) {
+                    continue;
+                }
+
+                board.loadFen(toFen(sideToMove, whiteKing, blackKing, piece, PIECE_CODES[set]));
+                MoveList moves = board.generateLegalMoves(sideToMove);
+                if (moves.size() == 0) {
+                    plies[i] = board.isInCheck() ? 0 : DRAWN;
+                    continue;
+                }
+                plies[i] = UNDECIDED;
+                for (Move move : moves) {
+                    board.makeMove(move);
+                    children.push_back(child(board));
+                    board.unmakeMove();
+                }
+            }
+            firstChild[Tablebase::TABLE_SIZE] = children.size();
+        }
+
+        int32_t child(const Board& board) const {
+            Square whiteKing = Bitboards::lsb(board.getPieces(Colour::White, Piece::PieceType::King));
+            Square blackKing = Bitboards::lsb(board.getPieces(Colour::Black, Piece::PieceType::King));
+            Bitboard others = board.getPieces(Colour::White) & ~Bitboards::squareBB(whiteKing);
+            if (!others) {
+                return -1 - Tablebase::DRAW; //the extra piece was taken
+            }
+
+            Square piece = Bitboards::lsb(others);
+            size_t index = Tablebase::index(board.getSideToMove(), whiteKing, blackKing, piece);
+            Tablebase::Set childSet;
+            switch (board.getPieceTypeAt(piece)) {
+                case Piece::PieceType::Queen: childSet = Tablebase::KQK; break;
+                case Piece::PieceType::Rook: childSet = Tablebase::KRK; break;
+                case Piece::PieceType::Pawn: childSet = Tablebase::KPK; break;
+                default: return -1 - Tablebase::DRAW; //underpromotion to a minor piece
+            }
+            if (childSet == set) {
+                return static_cast<int32_t>(index);
+            }
+            return -1 - static_cast<int32_t>((*promotions[childSet])[index]);
+        }
+
+        Tablebase::Result resultOf(int32_t child) const {
+            if (child < 0) {
+                return Tablebase::decode(static_cast<uint8_t>(-1 - child));
+            }
+            int16_t value = plies[child];
+            if (value < 0) {
+                return Tablebase::Result{Tablebase::Wdl::Draw, -1}; //drawn or not decided yet
+            }
+            return Tablebase::Result{value % 2 == 1 ? Tablebase::Wdl::Win : Tablebase::Wdl::Loss, value};
+        }
+
+        //decides every position won (n odd) or lost (n even) in n plies, returns how many
+        size_t pass(int n) {
+            size_t decided = 0;
+            for (size_t i = 0; i < Tablebase::TABLE_SIZE; i++) {
+                if (plies[i] != UNDECIDED) {
+                    continue;
+                }
+                bool result = n % 2 == 0;
+                for (uint32_t c = firstChild[i]; c < firstChild[i + 1]; c++) {
+                    Tablebase::Result reply = resultOf(children[c]);
+                    if (n % 2 == 1 && reply.wdl == Tablebase::Wdl::Loss && reply.pliesToMate == n - 1) {
+                        result = true;
+                        break;
+                    }
+                    if (n % 2 == 0 && (reply.wdl != Tablebase::Wdl::Win || reply.pliesToMate > n - 1)) {
+                        result = false;
+                        break;
+                    }
+                }
+                if (result) {
+                    plies[i] = static_cast<int16_t>(n);
+                    ++decided;
+                }
+            }
+            return decided;
+        }
+
+        int longestExternal() const { //the longest mate reached through a promotion
+            int longest = 0;
+            for (int32_t c : children) {
+                if (c < 0) {
+                    Tablebase::Result result = resultOf(c);
+                    longest = result.pliesToMate > longest ? result.pliesToMate : longest;
+                }
+            }
+            return longest;
+        }
+
+        std::vector<uint8_t> solve() {
+            int external = longestExternal();
+            int idle = 0; //passes in a row that decided nothing
+            for (int n = 1; n < Tablebase::ILLEGAL - 1; n++) {
+                idle = pass(n) ? 0 : idle + 1;
+                if (idle >= 2 && n > external) {
+                    break;
+                }
+            }
+
+            std::vector<uint8_t> table(Tablebase::TABLE_SIZE);
+            for (size_t i = 0; i < Tablebase::TABLE_SIZE; i++) {
+                if (plies[i] == ILLEGAL) {
+                    table[i] = Tablebase::ILLEGAL;
+                }
+                else if (plies[i] < 0) {
+                    table[i] = Tablebase::DRAW;
+                }
+                else {
+                    table[i] = Tablebase::encode(Tablebase::Result{plies[i] % 2 == 1 ? Tablebase::Wdl::Win : Tablebase::Wdl::Loss, plies[i]});
+                }
+            }
+            return table;
+        }
+    };
+
+    void report(Tablebase::Set set, const std::vector<uint8_t>& table) {
+        size_t wins = 0, draws = 0, losses = 0;
+        int longest = 0;
+        for (uint8_t value : table) {
+            if (value == Tablebase::ILLEGAL) {
+                continue;
+            }
+            Tablebase::Result result = Tablebase::decode(value);
+            switch (result.wdl) {
+                case Tablebase::Wdl::Win: ++wins; break;
+                case Tablebase::Wdl::Draw: ++draws; break;
+                case Tablebase::Wdl::Loss: ++losses; break;
+            }
+            longest = result.pliesToMate > longest ? result.pliesToMate : longest;
+        }
+        std::cout << Tablebase::fileName(set) << ": " << wins << " won, " << draws << " drawn, " << losses
+                  << " lost, longest mate " << longest << " plies\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <directory>\n";
+        return 1;
+    }
+    std::string directory = argv[1];
+
+    Board board{8};
+    std::vector<uint8_t> tables[Tablebase::NUM_SETS];
+    for (int s = 0; s < Tablebase::NUM_SETS; s++) { //KPK last, its promotions need the others
+        Generator generator;
+        generator.set = static_cast<Tablebase::Set>(s);
+        for (int t = 0; t < Tablebase::NUM_SETS; t++) {
+            generator.promotions[t] = &tables[t];
+        }
+        generator.setUp(board);
+        tables[s] = generator.solve();
+        report(generator.set, tables[s]);
+
+        std::string path = directory + "/" + Tablebase::fileName(generator.set);
+        std::ofstream out{path, std::ios::binary};
+        unsigned char header[Tablebase::HEADER_SIZE];
+        Tablebase::writeHeader(header, generator.set);
+        out.write(reinterpret_cast<const char*>(header), Tablebase::HEADER_SIZE);
+        out.write(reinterpret_cast<const char*>(tables[s].data()), tables[s].size());
+        if (!out) {
+            std::cerr << "could not write " << path << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}